@@ -0,0 +1,204 @@
+/*
+ * Benchmarks of the h5pp read/write paths.
+ *
+ * Usage: h5pp-bench [--quick] [--output <results.json>] [--label <text>] [--file <scratch.h5>]
+ *
+ * Results are written as JSON, to stdout by default, so that runs on different commits can be compared.
+ * Use --label to tag a run, e.g. with the commit hash. --quick makes the datasets smaller for a fast sanity check.
+ */
+
+#include <h5pp/h5pp.h>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+namespace bench {
+    struct Result {
+        std::string name;
+        std::string params;
+        size_t      calls   = 0;
+        size_t      bytes   = 0; // Bytes moved per call
+        double      seconds = 0; // Total time of all calls
+    };
+
+    std::vector<Result> results;
+
+    /*! Calls func(i) for i in [0,calls), once untimed to warm up, and records the total time */
+    template<typename Func>
+    void run(const std::string &name, const std::string &params, size_t calls, size_t bytes, Func &&func) {
+        func(calls); // Warm-up, with an index that is not reused by the timed calls
+        auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < calls; i++) func(i);
+        auto   stop    = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        results.push_back({name, params, calls, bytes, seconds});
+        std::cerr << name << " " << params << ": " << 1e6 * seconds / static_cast<double>(calls) << " us/call";
+        if(bytes > 0) std::cerr << " | " << static_cast<double>(bytes * calls) / seconds / 1e6 << " MB/s";
+        std::cerr << std::endl;
+    }
+
+    std::string toJson(const std::string &label, bool quick) {
+        unsigned hdf5Major = 0, hdf5Minor = 0, hdf5Release = 0;
+        H5get_libversion(&hdf5Major, &hdf5Minor, &hdf5Release);
+        std::ostringstream json;
+        json << "{\n";
+        json << "  \"label\": \"" << label << "\",\n";
+        json << "  \"hdf5\": \"" << hdf5Major << "." << hdf5Minor << "." << hdf5Release << "\",\n";
+        json << "  \"quick\": " << (quick ? "true" : "false") << ",\n";
+        json << "  \"results\": [\n";
+        for(size_t i = 0; i < results.size(); i++) {
+            const auto &res       = results[i];
+            double      perCall   = res.seconds / static_cast<double>(res.calls);
+            double      bytesRate = res.bytes > 0 ? static_cast<double>(res.bytes * res.calls) / res.seconds : 0.0;
+            json << "    {\"name\": \"" << res.name << "\", \"params\": \"" << res.params << "\", \"calls\": " << res.calls << ", \"bytes_per_call\": " << res.bytes
+                 << ", \"seconds\": " << res.seconds << ", \"seconds_per_call\": " << perCall << ", \"bytes_per_second\": " << bytesRate << "}"
+                 << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        json << "  ]\n}\n";
+        return json.str();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    bool        quick = false;
+    std::string outputJson;
+    std::string label;
+    std::string scratchFile = "output/bench.h5";
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if(arg == "--quick")
+            quick = true;
+        else if(arg == "--output" and i + 1 < argc)
+            outputJson = argv[++i];
+        else if(arg == "--label" and i + 1 < argc)
+            label = argv[++i];
+        else if(arg == "--file" and i + 1 < argc)
+            scratchFile = argv[++i];
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--output <results.json>] [--label <text>] [--file <scratch.h5>]" << std::endl;
+            return 1;
+        }
+    }
+
+    const size_t smallCalls = quick ? 100 : 2000;
+    const size_t largeCalls = quick ? 2 : 5;
+    const size_t largeSize  = quick ? (1ul << 20ul) : (8ul << 20ul); // Number of doubles: 8 MB or 64 MB
+
+    h5pp::File file(scratchFile, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, 3);
+
+    // Slowly varying values, so that compression has something to work with
+    std::vector<double> large(largeSize);
+    for(size_t i = 0; i < large.size(); i++) large[i] = std::round(1000.0 * std::sin(static_cast<double>(i) * 1e-4));
+    const size_t largeBytes = large.size() * sizeof(double);
+
+    // Latency of small writes, with and without keeping the file open
+    std::vector<double> small(16, 1.0);
+    for(bool keepOpen : {false, true}) {
+        file.setKeepFileOpen(keepOpen);
+        std::string params = keepOpen ? "keep-open" : "default";
+        bench::run("write_small_new", params, smallCalls, small.size() * sizeof(double), [&](size_t i) {
+            file.writeDataset(small, "small/" + params + "/dset_" + std::to_string(i));
+        });
+        bench::run("write_small_overwrite", params, smallCalls, small.size() * sizeof(double), [&](size_t) { file.writeDataset(small, "small/" + params + "/overwrite"); });
+        bench::run("read_small", params, smallCalls, small.size() * sizeof(double), [&](size_t) { file.readDataset(small, "small/" + params + "/overwrite"); });
+        bench::run("write_attribute", params, smallCalls, sizeof(double), [&](size_t i) {
+            file.writeAttribute(static_cast<double>(i), "attr_" + std::to_string(i), "small/" + params + "/overwrite");
+        });
+    }
+    file.setKeepFileOpen(false);
+
+    // Many small datasets written together in one batch, to compare with write_small_new
+    const size_t batchItems = 100;
+    bench::run("write_small_batch", "batch_" + std::to_string(batchItems), smallCalls / batchItems, batchItems * small.size() * sizeof(double), [&](size_t i) {
+        auto batch = file.beginBatch();
+        for(size_t j = 0; j < batchItems; j++) batch.writeDataset(small, "batch/call_" + std::to_string(i) + "/dset_" + std::to_string(j));
+        if(not batch.commit().empty()) throw std::runtime_error("Batch failed");
+    });
+
+    // Throughput of large writes and reads
+    std::vector<double> largeRead;
+    for(auto layout : {H5D_CONTIGUOUS, H5D_CHUNKED}) {
+        std::string params = layout == H5D_CONTIGUOUS ? "contiguous" : "chunked";
+        bench::run("write_large", params, largeCalls, largeBytes, [&](size_t) { file.writeDataset(large, "large/" + params, layout); });
+        bench::run("read_large", params, largeCalls, largeBytes, [&](size_t) { file.readDataset(largeRead, "large/" + params); });
+    }
+
+    // Scans of a large contiguous dataset through a mapped view, which skips the copy into a container
+    volatile double sum = 0.0;
+    bench::run("read_mapped", "contiguous", largeCalls, largeBytes, [&](size_t) {
+        auto view = file.mapDataset<double>("large/contiguous");
+        sum       = sum + std::accumulate(view.begin(), view.end(), 0.0);
+    });
+
+    // Scans of a large chunked dataset in blocks of rows, with and without reading the following blocks on a background thread
+    for(size_t readAhead : {0ul, 1ul, 4ul}) {
+        bench::run("read_blocks", "chunked_read_ahead_" + std::to_string(readAhead), largeCalls, largeBytes, [&](size_t) {
+            for(auto &block : file.iterateDataset<std::vector<double>>("large/chunked", largeSize / 16, readAhead))
+                sum = sum + std::accumulate(block.begin(), block.end(), 0.0);
+        });
+    }
+
+    // Throughput of appends, one block of rows at a time
+    const size_t        appendCalls = quick ? 100 : 1000;
+    std::vector<double> appendBlock(largeSize / 256, 1.0);
+    bench::run("append", "block_" + std::to_string(appendBlock.size()), appendCalls, appendBlock.size() * sizeof(double), [&](size_t) {
+        file.appendToDataset(appendBlock, "append/series");
+    });
+
+    // Compressed vs uncompressed chunked datasets, across chunk sizes
+    for(size_t chunkBytes : {64ul << 10ul, 256ul << 10ul, 1ul << 20ul, 4ul << 20ul}) {
+        file.setDefaultChunkBytes(chunkBytes);
+        for(unsigned int level : {0u, 1u, 6u}) {
+            std::string params   = "chunk_" + std::to_string(chunkBytes >> 10ul) + "KiB_deflate_" + std::to_string(level);
+            std::string dsetName = "compression/" + params;
+            bench::run("write_chunked", params, largeCalls, largeBytes, [&](size_t) { file.writeDataset(large, dsetName, H5D_CHUNKED, std::nullopt, level); });
+            bench::run("read_chunked", params, largeCalls, largeBytes, [&](size_t) { file.readDataset(largeRead, dsetName); });
+        }
+    }
+    file.setDefaultChunkBytes(h5pp::constants::defaultChunkBytes);
+
+    // Deflated chunks decompressed on several threads while the raw chunks are read on one
+    const size_t readThreads = std::max(2u, std::thread::hardware_concurrency());
+    file.setReadThreads(readThreads);
+    for(unsigned int level : {1u, 6u}) {
+        std::string params = "chunk_256KiB_deflate_" + std::to_string(level) + "_threads_" + std::to_string(readThreads);
+        bench::run("read_chunked_parallel", params, largeCalls, largeBytes, [&](size_t) {
+            file.readDataset(largeRead, "compression/chunk_256KiB_deflate_" + std::to_string(level));
+        });
+    }
+    file.setReadThreads(1);
+
+    // Deflated chunks compressed on several threads while the compressed chunks are written on one
+    file.setWriteThreads(readThreads);
+    for(unsigned int level : {1u, 6u}) {
+        std::string params = "chunk_256KiB_deflate_" + std::to_string(level) + "_threads_" + std::to_string(readThreads);
+        bench::run("write_chunked_parallel", params, largeCalls, largeBytes, [&](size_t) {
+            file.writeDataset(large, "compression/chunk_256KiB_deflate_" + std::to_string(level));
+        });
+    }
+    file.setWriteThreads(1);
+
+#ifdef H5PP_EIGEN3
+    // Cost of converting column-major Eigen objects to and from the row-major layout on file
+    using MatrixRowMajor = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    const auto      side        = static_cast<Eigen::Index>(std::sqrt(static_cast<double>(largeSize)));
+    Eigen::MatrixXd colMajor    = Eigen::MatrixXd::Random(side, side);
+    MatrixRowMajor  rowMajor    = colMajor;
+    const size_t    matrixBytes = static_cast<size_t>(colMajor.size()) * sizeof(double);
+    bench::run("write_eigen", "row_major", largeCalls, matrixBytes, [&](size_t) { file.writeDataset(rowMajor, "eigen/rowMajor"); });
+    bench::run("write_eigen", "col_major", largeCalls, matrixBytes, [&](size_t) { file.writeDataset(colMajor, "eigen/colMajor"); });
+    bench::run("read_eigen", "row_major", largeCalls, matrixBytes, [&](size_t) { file.readDataset(rowMajor, "eigen/rowMajor"); });
+    bench::run("read_eigen", "col_major", largeCalls, matrixBytes, [&](size_t) { file.readDataset(colMajor, "eigen/colMajor"); });
+#endif
+
+    std::string json = bench::toJson(label, quick);
+    if(outputJson.empty())
+        std::cout << json;
+    else
+        std::ofstream(outputJson) << json;
+    return 0;
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+namespace h5pp {
+
+    /*!
+     \brief Copies of data that wait in the AsyncQueue, recycled between writes of the same type.
+
+     Copy-assigning into a recycled buffer reuses its capacity, so repeated writes of similar sizes stop allocating.
+     Buffers go back to the pool when the write that used them is done, and at most maxBuffers are kept.
+    */
+    template<typename T>
+    class StagingPool : public std::enable_shared_from_this<StagingPool<T>> {
+        private:
+        std::mutex                      mutex;
+        std::vector<std::unique_ptr<T>> buffers;
+        size_t                          maxBuffers;
+
+        void recycle(std::unique_ptr<T> buffer) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(buffers.size() < maxBuffers) buffers.push_back(std::move(buffer));
+        }
+
+        public:
+        explicit StagingPool(size_t maxBuffers_) : maxBuffers(maxBuffers_) {}
+
+        [[nodiscard]] std::shared_ptr<T> stage(const T &data) {
+            std::unique_ptr<T> buffer;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(not buffers.empty()) {
+                    buffer = std::move(buffers.back());
+                    buffers.pop_back();
+                }
+            }
+            if(buffer)
+                *buffer = data;
+            else
+                buffer = std::make_unique<T>(data);
+            std::weak_ptr<StagingPool> pool = this->shared_from_this();
+            return std::shared_ptr<T>(buffer.release(), [pool](T *ptr) {
+                std::unique_ptr<T> done(ptr);
+                if(auto alive = pool.lock()) alive->recycle(std::move(done));
+            });
+        }
+    };
+
+    /*!
+     \brief Runs tasks in order on a single background thread, e.g. the writes of File::writeDatasetAsync.
+
+     Pushing blocks while maxDepth tasks are waiting, which bounds the memory held by staged data and keeps producers
+     from running ahead of the disk. The destructor finishes all pending tasks before joining the thread.
+     Exceptions thrown by a task are delivered through the future returned by push.
+    */
+    class AsyncQueue {
+        private:
+        std::mutex                                       mutex;
+        std::condition_variable                          taskAdded; /*!< Wakes the worker */
+        std::condition_variable                          taskDone;  /*!< Wakes producers waiting for room in the queue, or for the queue to drain */
+        std::deque<std::packaged_task<void()>>           tasks;
+        size_t                                           maxDepth;
+        bool                                             running  = false; /*!< A task has been taken off the queue and is not done yet */
+        bool                                             stopping = false;
+        std::map<std::type_index, std::shared_ptr<void>> pools;
+        std::thread                                      worker; /*!< Declared last, so that it starts after the members above are initialized */
+
+        void work() {
+            while(true) {
+                std::packaged_task<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    taskAdded.wait(lock, [this] { return stopping or not tasks.empty(); });
+                    if(tasks.empty()) return; // Stopping, and nothing left to do
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                    running = true;
+                }
+                task();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    running = false;
+                }
+                taskDone.notify_all();
+            }
+        }
+
+        public:
+        explicit AsyncQueue(size_t maxDepth_) : maxDepth(std::max<size_t>(1, maxDepth_)), worker(&AsyncQueue::work, this) {}
+        ~AsyncQueue() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            taskAdded.notify_one();
+            worker.join();
+        }
+        AsyncQueue(const AsyncQueue &) = delete;
+        AsyncQueue &operator=(const AsyncQueue &) = delete;
+
+        template<typename Task>
+        [[nodiscard]] std::future<void> push(Task &&task) {
+            std::packaged_task<void()> packagedTask(std::forward<Task>(task));
+            auto                       future = packagedTask.get_future();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskDone.wait(lock, [this] { return tasks.size() < maxDepth; });
+                tasks.push_back(std::move(packagedTask));
+            }
+            taskAdded.notify_one();
+            return future;
+        }
+
+        /*! Copies data into a staging buffer taken from the pool of its type */
+        template<typename T>
+        [[nodiscard]] std::shared_ptr<T> stage(const T &data) {
+            std::shared_ptr<StagingPool<T>> pool;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto &                      entry = pools[std::type_index(typeid(T))];
+                if(not entry) entry = std::make_shared<StagingPool<T>>(maxDepth + 1);
+                pool = std::static_pointer_cast<StagingPool<T>>(entry);
+            }
+            return pool->stage(data);
+        }
+
+        /*! Blocks until all pushed tasks are done */
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskDone.wait(lock, [this] { return tasks.empty() and not running; });
+        }
+
+        [[nodiscard]] size_t size() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return tasks.size() + (running ? 1 : 0);
+        }
+
+        void setMaxDepth(size_t maxDepth_) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                maxDepth = std::max<size_t>(1, maxDepth_);
+            }
+            taskDone.notify_all();
+        }
+
+        [[nodiscard]] bool isWorkerThread() const { return std::this_thread::get_id() == worker.get_id(); }
+    };
+}
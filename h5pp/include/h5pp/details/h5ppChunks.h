@@ -0,0 +1,417 @@
+#pragma once
+#include "h5ppFilters.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <hdf5.h>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef H5PP_ZLIB
+    #include <zlib.h>
+#endif
+
+/*!
+ * Applies and undoes the filter pipeline of raw chunks, as written with H5Dwrite_chunk and read with H5Dread_chunk, without calling into HDF5.
+ * This lets chunks be compressed and decompressed on several threads while HDF5 itself is only used from one.
+ * Deflate needs zlib, which is used when H5PP_ZLIB is defined. CMake defines it when it links ZLIB::ZLIB, otherwise define it and link with -lz.
+ * */
+namespace h5pp::chunk {
+
+    /*! Whether a filter can be applied and undone here. Other filters, e.g. plugins or fletcher32 checksums, are left to HDF5 */
+    [[nodiscard]] inline bool canDecode(H5Z_filter_t id) {
+        switch(id) {
+            case H5Z_FILTER_SHUFFLE: return true;
+#ifdef H5PP_ZLIB
+            case H5Z_FILTER_DEFLATE: return true;
+#endif
+            default: return false;
+        }
+    }
+
+    [[nodiscard]] inline bool canEncode(H5Z_filter_t id) { return canDecode(id); }
+
+    /*! Byte shuffle of elements of typeSize bytes: the first bytes of all elements come first, then the second bytes, and so on.
+     *  Trailing bytes that don't make up a whole element are not shuffled */
+    inline void shuffle(const std::byte *in, std::byte *out, size_t bytes, size_t typeSize) {
+        if(typeSize <= 1) {
+            std::memcpy(out, in, bytes);
+            return;
+        }
+        size_t numElements = bytes / typeSize;
+        for(size_t byte = 0; byte < typeSize; byte++) {
+            std::byte *dst = out + byte * numElements;
+            for(size_t elem = 0; elem < numElements; elem++) dst[elem] = in[elem * typeSize + byte];
+        }
+        size_t shuffled = numElements * typeSize;
+        std::memcpy(out + shuffled, in + shuffled, bytes - shuffled);
+    }
+
+    /*! Undo the byte shuffle of elements of typeSize bytes. Trailing bytes that don't make up a whole element are not shuffled */
+    inline void unshuffle(const std::byte *in, std::byte *out, size_t bytes, size_t typeSize) {
+        if(typeSize <= 1) {
+            std::memcpy(out, in, bytes);
+            return;
+        }
+        size_t numElements = bytes / typeSize;
+        for(size_t byte = 0; byte < typeSize; byte++) {
+            const std::byte *src = in + byte * numElements;
+            for(size_t elem = 0; elem < numElements; elem++) out[elem * typeSize + byte] = src[elem];
+        }
+        size_t shuffled = numElements * typeSize;
+        std::memcpy(out + shuffled, in + shuffled, bytes - shuffled);
+    }
+
+#ifdef H5PP_ZLIB
+    /*! Decompress deflated bytes into out, which is resized to the number of decompressed bytes */
+    inline void inflate(const std::vector<std::byte> &in, std::vector<std::byte> &out, size_t chunkBytes) {
+        out.resize(chunkBytes);
+        auto outBytes = static_cast<uLongf>(out.size());
+        int  err      = uncompress(reinterpret_cast<Bytef *>(out.data()), &outBytes, reinterpret_cast<const Bytef *>(in.data()), static_cast<uLong>(in.size()));
+        if(err != Z_OK) throw std::runtime_error("Failed to inflate chunk: zlib error " + std::to_string(err));
+        out.resize(outBytes);
+    }
+
+    /*! Compress bytes with deflate at the given level, as the deflate filter of HDF5 does */
+    inline void deflate(const std::vector<std::byte> &in, std::vector<std::byte> &out, unsigned int level) {
+        out.resize(compressBound(static_cast<uLong>(in.size())));
+        auto outBytes = static_cast<uLongf>(out.size());
+        int  err      = compress2(reinterpret_cast<Bytef *>(out.data()),
+                            &outBytes,
+                            reinterpret_cast<const Bytef *>(in.data()),
+                            static_cast<uLong>(in.size()),
+                            static_cast<int>(std::min(level, 9u)));
+        if(err != Z_OK) throw std::runtime_error("Failed to deflate chunk: zlib error " + std::to_string(err));
+        out.resize(outBytes);
+    }
+#endif
+
+    /*! Apply the filters to a chunk in order. The result is left in raw */
+    inline void encode(std::vector<std::byte> &raw, std::vector<std::byte> &scratch, const std::vector<Filter> &pipeline, size_t typeSize) {
+        for(const auto &filter : pipeline) {
+            switch(filter.id) {
+                case H5Z_FILTER_SHUFFLE: {
+                    scratch.resize(raw.size());
+                    shuffle(raw.data(), scratch.data(), raw.size(), typeSize);
+                    break;
+                }
+#ifdef H5PP_ZLIB
+                case H5Z_FILTER_DEFLATE: {
+                    deflate(raw, scratch, filter.params.empty() ? 6u : filter.params[0]);
+                    break;
+                }
+#endif
+                default: throw std::runtime_error("Can't encode filter: " + filter.name);
+            }
+            raw.swap(scratch);
+        }
+    }
+
+    /*! Undo the filters of a chunk in reverse order, skipping those whose bit is set in filterMask. The result is left in raw */
+    inline void decode(std::vector<std::byte> &     raw,
+                       std::vector<std::byte> &     scratch,
+                       const std::vector<Filter> &  pipeline,
+                       uint32_t                     filterMask,
+                       size_t                       chunkBytes,
+                       size_t                       typeSize) {
+        for(size_t idx = pipeline.size(); idx-- > 0;) {
+            if((filterMask & (1u << idx)) != 0) continue; // The filter was skipped for this chunk when it was written
+            switch(pipeline[idx].id) {
+                case H5Z_FILTER_SHUFFLE: {
+                    scratch.resize(raw.size());
+                    unshuffle(raw.data(), scratch.data(), raw.size(), typeSize);
+                    break;
+                }
+#ifdef H5PP_ZLIB
+                case H5Z_FILTER_DEFLATE: {
+                    inflate(raw, scratch, chunkBytes);
+                    break;
+                }
+#endif
+                default: throw std::runtime_error("Can't decode filter: " + pipeline[idx].name);
+            }
+            raw.swap(scratch);
+        }
+        if(raw.size() != chunkBytes)
+            throw std::runtime_error("Decoded chunk has " + std::to_string(raw.size()) + " bytes, expected " + std::to_string(chunkBytes));
+    }
+
+    /*! Call copyRow(chunkByte, dataByte, rowBytes) for each row, along the last dimension, of the part of a chunk that lies inside
+     *  a row-major dataset. Chunks on the edges are clipped to the dataset */
+    template<typename CopyRow>
+    void forEachRow(const std::vector<hsize_t> &chunkOffset,
+                    const std::vector<hsize_t> &chunkDims,
+                    const std::vector<hsize_t> &dims,
+                    size_t                      typeSize,
+                    CopyRow &&                  copyRow) {
+        size_t               ndims = dims.size();
+        std::vector<hsize_t> extent(ndims), chunkStride(ndims, 1), dimStride(ndims, 1);
+        for(size_t d = 0; d < ndims; d++) extent[d] = std::min(chunkDims[d], dims[d] - chunkOffset[d]);
+        for(size_t d = ndims - 1; d > 0; d--) {
+            chunkStride[d - 1] = chunkStride[d] * chunkDims[d];
+            dimStride[d - 1]   = dimStride[d] * dims[d];
+        }
+        // Count through the dimensions before the last like an odometer
+        size_t               rowBytes = extent[ndims - 1] * typeSize;
+        std::vector<hsize_t> idx(ndims, 0);
+        while(true) {
+            size_t src = 0, dst = chunkOffset[ndims - 1];
+            for(size_t d = 0; d + 1 < ndims; d++) {
+                src += idx[d] * chunkStride[d];
+                dst += (chunkOffset[d] + idx[d]) * dimStride[d];
+            }
+            copyRow(src * typeSize, dst * typeSize, rowBytes);
+            size_t d = ndims - 1;
+            while(d > 0) {
+                if(++idx[d - 1] < extent[d - 1]) break;
+                idx[d - 1] = 0;
+                d--;
+            }
+            if(d == 0) return;
+        }
+    }
+
+    /*! Copy a decoded chunk into a row-major buffer that holds the whole dataset */
+    inline void scatter(const std::byte *            chunk,
+                        std::byte *                  dest,
+                        const std::vector<hsize_t> & chunkOffset,
+                        const std::vector<hsize_t> & chunkDims,
+                        const std::vector<hsize_t> & dims,
+                        size_t                       typeSize) {
+        forEachRow(chunkOffset, chunkDims, dims, typeSize, [&](size_t chunkByte, size_t dataByte, size_t rowBytes) {
+            std::memcpy(dest + dataByte, chunk + chunkByte, rowBytes);
+        });
+    }
+
+    /*! Copy a chunk out of a row-major buffer that holds the whole dataset. The parts of chunks on the edges that lie outside
+     *  the dataset are left as they are, i.e. zero for a new chunk, which is the default fill value */
+    inline void gather(const std::byte *            src,
+                       std::byte *                  chunk,
+                       const std::vector<hsize_t> & chunkOffset,
+                       const std::vector<hsize_t> & chunkDims,
+                       const std::vector<hsize_t> & dims,
+                       size_t                       typeSize) {
+        forEachRow(chunkOffset, chunkDims, dims, typeSize, [&](size_t chunkByte, size_t dataByte, size_t rowBytes) {
+            std::memcpy(chunk + chunkByte, src + dataByte, rowBytes);
+        });
+    }
+
+    /*!
+     \brief Decodes raw chunks and scatters them into the buffer of a dataset on a pool of worker threads.
+
+     The caller reads raw chunks from HDF5 on its own thread and pushes them here. Pushing blocks while a few chunks per worker
+     are waiting, which bounds the memory held by raw chunks. The first error thrown by a worker is rethrown by push or finish.
+    */
+    class ParallelDecoder {
+        private:
+        struct Task {
+            std::vector<hsize_t>   offset;
+            uint32_t               filterMask;
+            std::vector<std::byte> raw;
+        };
+        const std::vector<Filter> & pipeline;
+        const std::vector<hsize_t> &dims;
+        const std::vector<hsize_t> &chunkDims;
+        size_t                      typeSize;
+        size_t                      chunkBytes;
+        std::byte *                 dest;
+        size_t                      maxQueue;
+        std::mutex                  mutex;
+        std::condition_variable     taskAdded;
+        std::condition_variable     taskTaken;
+        std::deque<Task>            tasks;
+        bool                        stopping = false;
+        std::exception_ptr          error;
+        std::vector<std::thread>    workers;
+
+        void work() {
+            std::vector<std::byte> scratch;
+            while(true) {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    taskAdded.wait(lock, [this] { return stopping or not tasks.empty(); });
+                    if(tasks.empty()) return;
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+                taskTaken.notify_one();
+                try {
+                    decode(task.raw, scratch, pipeline, task.filterMask, chunkBytes, typeSize);
+                    scatter(task.raw.data(), dest, task.offset, chunkDims, dims, typeSize);
+                } catch(...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(not error) error = std::current_exception();
+                    tasks.clear(); // No point in decoding the rest
+                    taskTaken.notify_all();
+                }
+            }
+        }
+
+        void join() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            taskAdded.notify_all();
+            for(auto &worker : workers) worker.join();
+            workers.clear();
+        }
+
+        public:
+        ParallelDecoder(size_t                      threads,
+                        const std::vector<Filter> & pipeline_,
+                        const std::vector<hsize_t> &dims_,
+                        const std::vector<hsize_t> &chunkDims_,
+                        size_t                      typeSize_,
+                        void *                      dest_)
+            : pipeline(pipeline_), dims(dims_), chunkDims(chunkDims_), typeSize(typeSize_), dest(static_cast<std::byte *>(dest_)),
+              maxQueue(2 * std::max<size_t>(1, threads)) {
+            chunkBytes = typeSize;
+            for(auto dim : chunkDims) chunkBytes *= dim;
+            for(size_t idx = 0; idx < std::max<size_t>(1, threads); idx++) workers.emplace_back(&ParallelDecoder::work, this);
+        }
+        ~ParallelDecoder() {
+            if(not workers.empty()) join();
+        }
+        ParallelDecoder(const ParallelDecoder &) = delete;
+        ParallelDecoder &operator=(const ParallelDecoder &) = delete;
+
+        void push(std::vector<hsize_t> offset, uint32_t filterMask, std::vector<std::byte> &&raw) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskTaken.wait(lock, [this] { return error or tasks.size() < maxQueue; });
+                if(error) std::rethrow_exception(error);
+                tasks.push_back({std::move(offset), filterMask, std::move(raw)});
+            }
+            taskAdded.notify_one();
+        }
+
+        /*! Wait until all pushed chunks are in place */
+        void finish() {
+            join();
+            if(error) std::rethrow_exception(error);
+        }
+    };
+
+    /*!
+     \brief Gathers chunks out of the buffer of a dataset and applies their filters on a pool of worker threads.
+
+     The caller takes the encoded chunks with next() and writes them with H5Dwrite_chunk on its own thread, in the order they
+     are done. Workers pause while a few encoded chunks per worker are waiting, which bounds the memory they hold.
+     The first error thrown by a worker is rethrown by next().
+    */
+    class ParallelEncoder {
+        public:
+        struct Chunk {
+            std::vector<hsize_t>   offset;
+            std::vector<std::byte> data;
+        };
+
+        private:
+        const std::vector<Filter> & pipeline;
+        const std::vector<hsize_t> &dims;
+        const std::vector<hsize_t> &chunkDims;
+        size_t                      typeSize;
+        size_t                      chunkBytes;
+        const std::byte *           src;
+        std::vector<hsize_t>        grid; /*!< Number of chunks along each dimension */
+        size_t                      numChunks = 1;
+        size_t                      maxQueue;
+        std::mutex                  mutex;
+        std::condition_variable     chunkDone;
+        std::condition_variable     chunkTaken;
+        std::deque<Chunk>           done;
+        size_t                      claimed   = 0; /*!< Chunks taken by workers */
+        size_t                      delivered = 0; /*!< Chunks returned by next */
+        bool                        stopping  = false;
+        std::exception_ptr          error;
+        std::vector<std::thread>    workers;
+
+        [[nodiscard]] std::vector<hsize_t> chunkOffset(size_t index) const {
+            std::vector<hsize_t> offset(dims.size());
+            for(size_t d = dims.size(); d-- > 0;) {
+                offset[d] = (index % grid[d]) * chunkDims[d];
+                index /= grid[d];
+            }
+            return offset;
+        }
+
+        void work() {
+            std::vector<std::byte> scratch;
+            while(true) {
+                size_t index;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(stopping or error or claimed == numChunks) return;
+                    index = claimed++;
+                }
+                try {
+                    Chunk chunk{chunkOffset(index), std::vector<std::byte>(chunkBytes)};
+                    gather(src, chunk.data.data(), chunk.offset, chunkDims, dims, typeSize);
+                    encode(chunk.data, scratch, pipeline, typeSize);
+                    std::unique_lock<std::mutex> lock(mutex);
+                    chunkTaken.wait(lock, [this] { return stopping or done.size() < maxQueue; });
+                    if(stopping) return;
+                    done.push_back(std::move(chunk));
+                } catch(...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(not error) error = std::current_exception();
+                }
+                chunkDone.notify_one();
+            }
+        }
+
+        public:
+        ParallelEncoder(size_t                      threads,
+                        const std::vector<Filter> & pipeline_,
+                        const std::vector<hsize_t> &dims_,
+                        const std::vector<hsize_t> &chunkDims_,
+                        size_t                      typeSize_,
+                        const void *                src_)
+            : pipeline(pipeline_), dims(dims_), chunkDims(chunkDims_), typeSize(typeSize_), src(static_cast<const std::byte *>(src_)),
+              maxQueue(2 * std::max<size_t>(1, threads)) {
+            chunkBytes = typeSize;
+            for(size_t d = 0; d < dims.size(); d++) {
+                chunkBytes *= chunkDims[d];
+                grid.push_back((dims[d] + chunkDims[d] - 1) / chunkDims[d]);
+                numChunks *= grid.back();
+            }
+            for(size_t idx = 0; idx < std::max<size_t>(1, threads); idx++) workers.emplace_back(&ParallelEncoder::work, this);
+        }
+        ~ParallelEncoder() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            chunkTaken.notify_all();
+            for(auto &worker : workers) worker.join();
+        }
+        ParallelEncoder(const ParallelEncoder &) = delete;
+        ParallelEncoder &operator=(const ParallelEncoder &) = delete;
+
+        /*! The next encoded chunk, or nothing when all chunks have been returned */
+        [[nodiscard]] std::optional<Chunk> next() {
+            std::optional<Chunk> chunk;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if(delivered == numChunks) return chunk;
+                chunkDone.wait(lock, [this] { return error or not done.empty(); });
+                if(error) std::rethrow_exception(error);
+                chunk = std::move(done.front());
+                done.pop_front();
+                delivered++;
+            }
+            chunkTaken.notify_one();
+            return chunk;
+        }
+    };
+}
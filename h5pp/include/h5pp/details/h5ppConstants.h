@@ -2,6 +2,12 @@
 #pragma once
 
 namespace h5pp::constants {
-    static constexpr unsigned long maxSizeCompact    = 32 * 1024;  // Max size of compact datasets is 32 kb
-    static constexpr unsigned long maxSizeContiguous = 512 * 1024; // Max size of contiguous datasets is 512 kb
+    static constexpr unsigned long maxSizeCompact         = 32 * 1024;        // Max size of compact datasets is 32 kb
+    static constexpr unsigned long maxSizeContiguous      = 512 * 1024;       // Max size of contiguous datasets is 512 kb
+    static constexpr unsigned long defaultChunkBytes      = 256 * 1024;       // Target size of chunks chosen by h5pp, so that several fit in the default chunk cache
+    static constexpr unsigned long maxSizeTransposeTile   = 8 * 1024 * 1024;  // Column-major Eigen data larger than this is transposed in tiles of at most this size
+    static constexpr unsigned long minSizeChunkCache      = 1024 * 1024;      // Smallest chunk cache suggested by h5pp, same as the HDF5 default of 1 MiB
+    static constexpr unsigned long maxSizeChunkCache      = 64 * 1024 * 1024; // Largest chunk cache suggested by h5pp, 64 MiB per open dataset
+    static constexpr unsigned long defaultAsyncQueueDepth = 8;                // Asynchronous writes that may wait in the queue before writeDatasetAsync blocks
+    static constexpr unsigned long coreDriverIncrement    = 1024 * 1024;      // Memory is added to in-memory files in steps of this many bytes, see H5Pset_fapl_core
 }
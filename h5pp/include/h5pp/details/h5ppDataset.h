@@ -0,0 +1,158 @@
+#pragma once
+#include "h5ppDatasetProperties.h"
+#include "h5ppHdf5.h"
+#include "h5ppHid.h"
+#include "h5ppLock.h"
+#include "h5ppLogger.h"
+#include "h5ppPropertyLists.h"
+#include "h5ppScan.h"
+#include "h5ppUtils.h"
+#include <hdf5.h>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace h5pp {
+
+    /*!
+     \brief A handle to an existing dataset, with properties cached between calls.
+
+     Obtain one with h5pp::File::openDataset(name). The handle keeps the dataset (and therefore the file) open until it is destroyed,
+     and remembers the type, dimensions and dataspaces of the dataset. Repeated writes with the same shape and type go straight to H5Dwrite
+     without looking up links, reopening the dataset or comparing types again.
+     Calls on different handles may be made from different threads. They are serialized behind the HDF5 lock, see h5pp::lock.
+     A single handle must not be used from several threads at once, since it updates its cached properties.
+    */
+    class Dataset {
+        private:
+        hid::h5f                       file;
+        hid::h5t                       fileType; /*!< The type of the dataset on file */
+        hid::h5t                       memType;  /*!< The type of the data in memory, for the last C++ type that passed the type check */
+        std::optional<std::type_index> checkedType;
+        std::vector<hsize_t>           maxDims;
+        DatasetProperties              props;
+        PropertyLists                  plists;
+        bool                           readOnly = false;
+
+        template<typename DataType>
+        void checkType() {
+            if(checkedType and checkedType.value() == std::type_index(typeid(DataType))) return;
+            if(props.ndims.value() != h5pp::utils::getRank<DataType>())
+                throw std::runtime_error("Number of dimensions in existing dataset (" + std::to_string(props.ndims.value()) + ") differ from dimensions in given data (" +
+                                         std::to_string(h5pp::utils::getRank<DataType>()) + ")");
+            hid::h5t type = h5pp::utils::getH5Type<DataType>();
+            if(not h5pp::hdf5::checkEqualTypesRecursive(fileType, type))
+                throw std::runtime_error("Given datatype does not match the type of an existing dataset: " + props.dsetName.value());
+            memType     = type;
+            checkedType = std::type_index(typeid(DataType));
+        }
+
+        void refreshSpaces() {
+            props.dataSpace = H5Dget_space(props.dataSet);
+            props.fileSpace = H5Dget_space(props.dataSet);
+            props.memSpace  = h5pp::utils::getMemSpace(props.size.value(), props.ndims.value(), props.dims.value());
+        }
+
+        void setExtent(const std::vector<hsize_t> &newDims) {
+            if(props.layout.value() != H5D_CHUNKED)
+                throw std::runtime_error("Dimensions not equal. Existing dataset [" + props.dsetName.value() +
+                                         "] does not have layout H5D_CHUNKED and can't be resized. Consider using H5D_CHUNKED layout for resizeable datasets");
+            for(size_t idx = 0; idx < newDims.size(); idx++) {
+                if(maxDims[idx] != H5S_UNLIMITED and newDims[idx] > maxDims[idx])
+                    throw std::runtime_error("Dimension too large. Existing dataset [" + props.dsetName.value() + "] has a maximum size [" + std::to_string(maxDims[idx]) +
+                                             "] in dimension [" + std::to_string(idx) + "], but the requested size is [" + std::to_string(newDims[idx]) + "]");
+            }
+            props.dims = newDims;
+            props.size = std::accumulate(newDims.begin(), newDims.end(), (hsize_t) 1, std::multiplies<>());
+            h5pp::hdf5::setDatasetExtent(props);
+            refreshSpaces();
+        }
+
+        public:
+        Dataset(const hid::h5f &file_, std::string_view dsetName, const PropertyLists &plists_ = PropertyLists()) : file(file_), plists(plists_) {
+            h5pp::lock::Guard guard;
+            props = h5pp::scan::getDatasetProperties_read(file, dsetName, std::nullopt, plists);
+            if(not props.dsetExists.value()) throw std::runtime_error("Could not open dataset handle: Dataset does not exist: [" + std::string(dsetName) + "]");
+            unsigned int intent = 0;
+            H5Fget_intent(file, &intent);
+            readOnly = (intent & H5F_ACC_RDWR) == 0;
+            fileType = props.dataType;
+            maxDims  = h5pp::hdf5::getMaxDimensions(props.dataSpace);
+            refreshSpaces();
+        }
+
+        [[nodiscard]] std::string                 getName() const { return props.dsetName.value(); }
+        [[nodiscard]] const std::vector<hsize_t> &getDimensions() const { return props.dims.value(); }
+        [[nodiscard]] hsize_t                     getSize() const { return props.size.value(); }
+        [[nodiscard]] int                         getRank() const { return props.ndims.value(); }
+        [[nodiscard]] H5D_layout_t                getLayout() const { return props.layout.value(); }
+        [[nodiscard]] const DatasetProperties &   getProperties() const { return props; }
+        [[nodiscard]] std::vector<Filter>         getFilters() const {
+            h5pp::lock::Guard guard;
+            return h5pp::hdf5::getFilters(props.plist_dset_create);
+        }
+
+        /*! Overwrite the dataset. Chunked datasets are resized if the given data has a different shape */
+        template<typename DataType>
+        void write(const DataType &data) {
+            if(readOnly) throw std::runtime_error("Attempted to write to read-only file");
+            h5pp::lock::Guard guard;
+            checkType<DataType>();
+            props.dataType = memType;
+            if constexpr(h5pp::type::sfinae::is_text_v<DataType>) {
+                // The size of text types depends on the data, so we need a fresh type every time
+                props.dataType = h5pp::utils::getH5Type<DataType>();
+                h5pp::utils::setStringSize(data, props.dataType);
+            }
+            auto dataDims = h5pp::utils::getDimensions(data);
+            if(dataDims != props.dims.value()) setExtent(dataDims);
+            props.bytes = h5pp::utils::getBytesTotal(data);
+            h5pp::hdf5::writeDataset(data, props, plists);
+        }
+
+        /*! Write data into the sub-region (hyperslab) starting at offset. Chunked datasets grow to fit the region if needed */
+        template<typename DataType>
+        void write(const DataType &data, const std::vector<hsize_t> &offset, const std::optional<std::vector<hsize_t>> &stride = std::nullopt) {
+            if(readOnly) throw std::runtime_error("Attempted to write to read-only file");
+            h5pp::lock::Guard guard;
+            checkType<DataType>();
+            props.dataType = memType;
+            h5pp::hdf5::writeDataset(data, props, offset, stride, plists);
+        }
+
+        /*! Read the whole dataset into the given container, which is resized if possible */
+        template<typename DataType, typename = std::enable_if_t<not std::is_const_v<DataType>>>
+        void read(DataType &data) {
+            // Same as h5pp::File::readDataset we read using the type on file
+            h5pp::lock::Guard guard;
+            props.dataType = fileType;
+            h5pp::hdf5::readDataset(data, props, plists);
+        }
+
+        template<typename DataType, typename = std::enable_if_t<not std::is_const_v<DataType>>>
+        [[nodiscard]] DataType read() {
+            DataType data;
+            read(data);
+            return data;
+        }
+
+        /*! Read the sub-region (hyperslab) given by offset, extent and an optional stride */
+        template<typename DataType, typename = std::enable_if_t<not std::is_const_v<DataType>>>
+        void read(DataType &data, const std::vector<hsize_t> &offset, const std::vector<hsize_t> &extent, const std::optional<std::vector<hsize_t>> &stride = std::nullopt) {
+            h5pp::lock::Guard guard;
+            props.dataType = fileType;
+            h5pp::hdf5::readDataset(data, props, offset, extent, stride, plists);
+        }
+
+        /*! Append data to a chunked dataset along the given axis. The remaining dimensions must match the dataset */
+        template<typename DataType>
+        void append(const DataType &data, size_t axis = 0) {
+            if(readOnly) throw std::runtime_error("Attempted to write to read-only file");
+            h5pp::lock::Guard guard;
+            checkType<DataType>();
+            props.dataType = memType;
+            h5pp::hdf5::appendDataset(data, props, axis, plists);
+        }
+    };
+}
@@ -0,0 +1,214 @@
+#pragma once
+#include "h5ppDataset.h"
+#include "h5ppPtrWrapper.h"
+#include "h5ppStats.h"
+#include "h5ppTypeSfinae.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <hdf5.h>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace h5pp {
+
+    /*!
+     \brief A range over successive blocks of rows of a dataset, for processing datasets larger than memory.
+
+     Obtain one with h5pp::File::iterateDataset<DataType>(dsetName, blockRows, readAhead), and loop over it with a range-based for loop.
+     Each block holds up to blockRows entries along the leading dimension, and all entries along the others, in row-major order.
+     The last block holds the remaining rows. Blocks are read into buffers that are reused, so a block is only valid until the
+     next one is taken, and a std::vector is only resized, without reallocating, for the last block.
+
+     With a read-ahead depth, a background thread reads up to that many blocks beyond the current one into a ring of depth + 1
+     buffers, which hides the latency of the disk and of decompression while the current block is processed. The time spent
+     waiting for blocks that were not ready yet is counted in getStats().stalls: when it is large, reading is the bottleneck.
+     The range keeps the dataset open until it is destroyed. It can't be copied or moved, since reads may be in flight.
+    */
+    template<typename DataType>
+    class DatasetBlocks {
+        static_assert(not std::is_const_v<DataType> and not std::is_pointer_v<DataType>, "Blocks are read into a container that h5pp can resize");
+        static_assert(not h5pp::type::sfinae::is_text_v<DataType>, "Blocks of text types can't be read");
+
+        public:
+        struct Stats {
+            IoStats::Timing reads;  /*!< Blocks read from file, on the background thread with read-ahead */
+            IoStats::Timing stalls; /*!< Waits for a block that was still being read */
+        };
+
+        private:
+        Dataset                 dataset;
+        hsize_t                 blockRows;
+        size_t                  readAhead;
+        std::vector<hsize_t>    dims;
+        std::vector<DataType>   buffers;         /*!< A ring of readAhead + 1 buffers */
+        size_t                  current = 0;     /*!< The buffer that holds the current block */
+        hsize_t                 row     = 0;     /*!< The first row of the current block */
+        bool                    started = false;
+        Stats                   stats;
+        // Shared with the background thread, under the mutex
+        mutable std::mutex      mutex;
+        std::condition_variable blockRead;
+        std::condition_variable blockTaken;
+        size_t                  ready    = 0;     /*!< Blocks read beyond the current one */
+        hsize_t                 fetchRow = 0;     /*!< The first row of the next block to read */
+        bool                    stopping = false;
+        std::exception_ptr      error;
+        std::thread             reader;
+
+        void readBlock(DataType &buffer, hsize_t firstRow) {
+            std::vector<hsize_t> offset(dims.size(), 0), extent = dims;
+            offset[0] = firstRow;
+            extent[0] = std::min(blockRows, dims[0] - firstRow);
+            auto size = std::accumulate(extent.begin(), extent.end(), static_cast<size_t>(1), std::multiplies<>());
+            auto t0   = std::chrono::steady_clock::now();
+            if constexpr(h5pp::type::sfinae::is_std_vector_v<DataType>) {
+                // Read through a wrapper, since std::vector only reads one-dimensional datasets
+                buffer.resize(size);
+                auto wrapper = h5pp::PtrWrapper(buffer.data(), size);
+                dataset.read(wrapper, offset, extent);
+            } else {
+                dataset.read(buffer, offset, extent);
+            }
+            auto                        nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.reads.count++;
+            stats.reads.nanoseconds += static_cast<uint64_t>(nanoseconds);
+            stats.reads.bytes += size * H5Tget_size(dataset.getProperties().dataType);
+        }
+
+        void readAheadLoop() {
+            while(true) {
+                size_t  slot;
+                hsize_t firstRow;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    blockTaken.wait(lock, [this] { return stopping or ready < readAhead or fetchRow >= dims[0]; });
+                    if(stopping or fetchRow >= dims[0]) return;
+                    // The slots after the current one, in order. The current one is never among them
+                    slot     = (current + 1 + ready) % buffers.size();
+                    firstRow = fetchRow;
+                }
+                try {
+                    readBlock(buffers[slot], firstRow);
+                } catch(...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = std::current_exception();
+                    blockRead.notify_one();
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ready++;
+                    fetchRow += blockRows;
+                }
+                blockRead.notify_one();
+            }
+        }
+
+        /*! Make the next block current, reading it here or waiting for the background thread */
+        void takeBlock() {
+            if(readAhead == 0) {
+                readBlock(buffers[current], row);
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if(ready == 0) {
+                    auto t0 = std::chrono::steady_clock::now();
+                    blockRead.wait(lock, [this] { return ready > 0 or error; });
+                    stats.stalls.count++;
+                    stats.stalls.nanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count());
+                }
+                // Blocks read before an error are still delivered
+                if(ready == 0) std::rethrow_exception(error);
+                current = (current + 1) % buffers.size();
+                ready--;
+            }
+            blockTaken.notify_one();
+        }
+
+        void start() {
+            if(started) return;
+            started = true;
+            if(dims[0] == 0) return;
+            if(readAhead > 0) {
+                // The background thread fills the slots after the current one, so start just before the first slot
+                current = buffers.size() - 1;
+                reader  = std::thread(&DatasetBlocks::readAheadLoop, this);
+            }
+            takeBlock();
+        }
+
+        void advance() {
+            row += blockRows;
+            if(row < dims[0]) takeBlock();
+        }
+
+        public:
+        class iterator {
+            private:
+            DatasetBlocks *range = nullptr;
+            [[nodiscard]] bool atEnd() const { return range == nullptr or range->row >= range->dims[0]; }
+
+            public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = DataType;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = DataType *;
+            using reference         = DataType &;
+
+            iterator() = default;
+            explicit iterator(DatasetBlocks *range_) : range(range_) {}
+            reference operator*() const { return range->buffers[range->current]; }
+            pointer   operator->() const { return &range->buffers[range->current]; }
+            iterator &operator++() {
+                range->advance();
+                return *this;
+            }
+            bool operator==(const iterator &other) const { return atEnd() == other.atEnd() and (atEnd() or range == other.range); }
+            bool operator!=(const iterator &other) const { return not(*this == other); }
+        };
+
+        DatasetBlocks(Dataset &&dataset_, hsize_t blockRows_, size_t readAhead_)
+            : dataset(std::move(dataset_)), blockRows(blockRows_), readAhead(readAhead_), dims(dataset.getDimensions()), buffers(readAhead_ + 1) {
+            if(blockRows == 0) throw std::runtime_error("Could not iterate over dataset [" + dataset.getName() + "]: The number of rows per block must be positive");
+            if(dims.empty()) throw std::runtime_error("Could not iterate over dataset [" + dataset.getName() + "]: Scalar datasets have no rows");
+        }
+        ~DatasetBlocks() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            blockTaken.notify_one();
+            if(reader.joinable()) reader.join();
+        }
+        DatasetBlocks(const DatasetBlocks &) = delete;
+        DatasetBlocks &operator=(const DatasetBlocks &) = delete;
+
+        /*! Reads the first block. A range can be iterated once */
+        [[nodiscard]] iterator begin() {
+            if(started) throw std::runtime_error("Could not iterate over dataset [" + dataset.getName() + "]: Blocks can only be iterated once");
+            start();
+            return iterator(this);
+        }
+        [[nodiscard]] iterator end() { return iterator(); }
+
+        [[nodiscard]] hsize_t                     getBlockRows() const { return blockRows; }
+        [[nodiscard]] size_t                      getReadAhead() const { return readAhead; }
+        [[nodiscard]] hsize_t                     getNumBlocks() const { return (dims[0] + blockRows - 1) / blockRows; }
+        [[nodiscard]] const std::vector<hsize_t> &getDimensions() const { return dims; }
+        /*! The first row of the current block along the leading dimension */
+        [[nodiscard]] hsize_t                     getBlockOffset() const { return row; }
+        [[nodiscard]] Stats                       getStats() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return stats;
+        }
+    };
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include "h5ppFilters.h"
 #include "h5ppHid.h"
 #include "h5ppLogger.h"
 #include <hdf5.h>
@@ -29,6 +30,7 @@ namespace h5pp {
         std::optional<std::vector<hsize_t>> dims;
         std::optional<std::vector<hsize_t>> chunkDims;
         std::optional<unsigned int>         compressionLevel;
+        std::optional<std::vector<Filter>>  filters; /*!< Filter pipeline for chunked datasets, applied after deflate from compressionLevel */
     };
 
 }
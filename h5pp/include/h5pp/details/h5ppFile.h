@@ -1,35 +1,54 @@
 
 #pragma once
 
+#include "h5ppAsyncQueue.h"
 #include "h5ppAttributeProperties.h"
 #include "h5ppConstants.h"
+#include "h5ppDataset.h"
+#include "h5ppDatasetBlocks.h"
 #include "h5ppDatasetProperties.h"
 #include "h5ppEigen.h"
 #include "h5ppFileCounter.h"
 #include "h5ppFilesystem.h"
 #include "h5ppHdf5.h"
 #include "h5ppHid.h"
+#include "h5ppLinkCache.h"
+#include "h5ppLock.h"
 #include "h5ppLogger.h"
+#include "h5ppMappedDataset.h"
 #include "h5ppOptional.h"
 #include "h5ppPermissions.h"
 #include "h5ppPropertyLists.h"
 #include "h5ppPtrWrapper.h"
 #include "h5ppScan.h"
+#include "h5ppStats.h"
 #include "h5ppTypeCompoundCreate.h"
+#include "h5ppTypeRegistry.h"
 #include "h5ppTypeSfinae.h"
 #include "h5ppUtils.h"
+#include <atomic>
 #include <cassert>
 #include <hdf5.h>
 #include <hdf5_hl.h>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <string>
 
 namespace h5pp {
+    class WriteBatch;
 
     /*!
      \brief Writes and reads data to a binary hdf5-file.
+
+     Files may be used from several threads at once, also the same File. Calls into HDF5 are serialized behind a process-wide lock,
+     see h5pp::lock, which is safe with HDF5 libraries built without thread-safety. Queries answered by the link cache in keep-open
+     mode don't take the lock. Settings, such as setKeepFileOpen or setChunkCache, should be made before the file is shared between threads.
+
+     Each File has its own logger, with its own level. The functions in h5pp::hdf5 log to the global h5pp::logger::log, which each call
+     on a File points to the logger of that File while it holds the lock, and restores the previous one when the call ends.
+     Dataset handles log to the global logger itself, see h5pp::logger::log.
     */
 
     class File {
@@ -40,12 +59,25 @@ namespace h5pp {
         AccessMode accessMode = AccessMode::READWRITE;
         CreateMode createMode = CreateMode::RENAME;
 
-        size_t   logLevel     = 2;
-        bool     logTimestamp = false;
-        hid::h5e error_stack;
+        size_t           logLevel     = 2;
+        bool             logTimestamp = false;
+        decltype(h5pp::logger::log) fileLog;   /*!< Logger of this file, created without the spdlog registry when the file is initialized */
+        bool             keepFileOpen = false; /*!< Keep a single file handle open between calls instead of opening/closing the file on every call */
+        mutable hid::h5f fileHandle;           /*!< Persistent file handle, only used when keepFileOpen is true */
+        mutable LinkCache linkCache;           /*!< Links known to exist in the file, only used when keepFileOpen is true */
+        bool             coreDriver   = false; /*!< The file lives in memory, see inMemory and fromBuffer. Its only handle is fileHandle */
+        hid::h5e         error_stack;
+        std::map<std::string, ChunkCache, std::less<>> dsetChunkCaches; /*!< Chunk caches of datasets with their own, by path relative to the root group */
         //        bool   defaultExtendable = false; /*!< New datasets with ndims >= can be set to extendable by default. For small datasets, setting this true results in larger
         //        file size */
-        unsigned int defaultCompressionLevel = 0;
+        unsigned int        defaultCompressionLevel = 0;
+        std::vector<Filter> defaultFilters; /*!< Filter pipeline for new chunked datasets. Empty means deflate with defaultCompressionLevel only */
+        size_t              defaultChunkBytes = h5pp::constants::defaultChunkBytes; /*!< Target size in bytes of automatically chosen chunk dimensions */
+        bool                trustedWrites     = false; /*!< Skip checking that written C++ types match the types of existing datasets and attributes */
+        mutable std::optional<IoStats> stats;              /*!< Statistics of the calls on this file, only collected when enabled with setCollectStats */
+        size_t                      asyncQueueDepth = h5pp::constants::defaultAsyncQueueDepth; /*!< Asynchronous writes that may wait before writeDatasetAsync blocks */
+        std::unique_ptr<AsyncQueue> asyncQueue;                                               /*!< Background thread for writeDatasetAsync, started on first use */
+        std::atomic<bool>           hasAsyncQueue{false};                                     /*!< Set once asyncQueue is started, so other threads can check it without the lock */
 
         public:
         bool hasInitialized = false;
@@ -58,14 +90,15 @@ namespace h5pp {
         // The user is responsible for linking to MPI and learning how to set properties for MPI usage
         PropertyLists plists;
 
-        File() { h5pp::logger::setLogger("h5pp", logLevel, logTimestamp); }
+        File() { fileLog = h5pp::logger::createLogger("h5pp", logLevel, logTimestamp); }
 
         File(const File &other) {
-            h5pp::logger::log->debug("Copy-constructing this file [{}] from given file: [{}]. Previously initialized (this): {}. Previously initialized (other): {}",
-                                     fileName.string(),
-                                     other.getFileName(),
-                                     hasInitialized,
-                                     other.hasInitialized);
+            auto lock = lockCall(); // The global logger is only read under the lock
+            H5PP_DEBUG("Copy-constructing this file [{}] from given file: [{}]. Previously initialized (this): {}. Previously initialized (other): {}",
+                       fileName.string(),
+                       other.getFileName(),
+                       hasInitialized,
+                       other.hasInitialized);
             *this = other;
         }
 
@@ -75,8 +108,9 @@ namespace h5pp {
                       size_t     logLevel_     = 2,
                       bool       logTimestamp_ = false)
             : fileName(std::move(FileName_)), accessMode(accessMode_), createMode(createMode_), logLevel(logLevel_), logTimestamp(logTimestamp_) {
-            h5pp::logger::setLogger("h5pp", logLevel, logTimestamp);
-            h5pp::logger::log->debug("Constructing h5pp file. Given path: [{}]", fileName.string());
+            fileLog   = h5pp::logger::createLogger("h5pp|" + fileName.filename().string(), logLevel, logTimestamp);
+            auto lock = lockCall();
+            H5PP_DEBUG("Constructing h5pp file. Given path: [{}]", fileName.string());
 
             if(accessMode_ == AccessMode::READONLY and createMode_ == CreateMode::TRUNCATE) {
                 logger::log->error("Options READONLY and TRUNCATE are incompatible.");
@@ -88,66 +122,133 @@ namespace h5pp {
         explicit File(fs::path FileName_, CreateMode createMode_, size_t logLevel_ = 2, bool logTimestamp_ = false)
             : File(std::move(FileName_), AccessMode::READWRITE, createMode_, logLevel_, logTimestamp_) {}
 
+        /*! Create an empty file in memory with the core driver of HDF5. Nothing touches the disk unless backingStore is true,
+         *  in which case the file is written to fileName when flushed or destroyed. Otherwise fileName is only a label, and the
+         *  contents are lost when the last copy of this File is destroyed, unless saved with toBuffer first.
+         *  As for files on disk, RENAME picks a new name for a backing store that exists, TRUNCATE overwrites it, and OPEN loads
+         *  an existing file into memory instead of creating an empty one */
+        [[nodiscard]] static File inMemory(const fs::path &fileName      = "h5pp-memory.h5",
+                                           bool            backingStore  = false,
+                                           CreateMode      createMode_   = CreateMode::RENAME,
+                                           size_t          logLevel_     = 2,
+                                           bool            logTimestamp_ = false) {
+            h5pp::lock::Guard guard;
+            PropertyLists     memoryPlists;
+            memoryPlists.setCoreDriver(h5pp::constants::coreDriverIncrement, backingStore);
+            fs::path path = backingStore ? fs::absolute(fileName) : fileName;
+            if(backingStore and createMode_ == CreateMode::RENAME and fs::exists(path)) path = h5pp::hdf5::getAvailableFileName(path);
+            // Without a backing store nothing on disk is overwritten, so a file of the same name is no reason to fail
+            if(not backingStore and createMode_ == CreateMode::RENAME) createMode_ = CreateMode::TRUNCATE;
+            auto handle = h5pp::hdf5::createMemoryFile(path, createMode_, memoryPlists);
+            return File(std::move(path), std::move(handle), AccessMode::READWRITE, std::move(memoryPlists), logLevel_, logTimestamp_);
+        }
+
+        /*! Open a copy of a file image, e.g. from toBuffer or read from a network, as an in-memory file. The buffer is not used after this call */
+        [[nodiscard]] static File fromBuffer(const void *buffer, size_t bytes, AccessMode accessMode_ = AccessMode::READWRITE, size_t logLevel_ = 2, bool logTimestamp_ = false) {
+            h5pp::lock::Guard guard;
+            auto              handle = h5pp::hdf5::openFileImage(buffer, bytes, accessMode_);
+            return File("h5pp-image.h5", std::move(handle), accessMode_, PropertyLists(), logLevel_, logTimestamp_);
+        }
+
+        [[nodiscard]] static File
+            fromBuffer(const std::vector<std::byte> &buffer, AccessMode accessMode_ = AccessMode::READWRITE, size_t logLevel_ = 2, bool logTimestamp_ = false) {
+            return fromBuffer(buffer.data(), buffer.size(), accessMode_, logLevel_, logTimestamp_);
+        }
+
         ~File() noexcept(false) {
-            auto savedLog = h5pp::logger::log->name();
-            h5pp::logger::setLogger("h5pp|exit", logLevel, logTimestamp);
-            if(h5pp::counter::ActiveFileCounter::getCount() == 1) { h5pp::type::compound::closeTypes(); }
+            hasAsyncQueue = false;
+            asyncQueue.reset(); // Finishes pending asynchronous writes
+            auto lock  = lockCall();
+            fileHandle = hid::h5f(); // Closes the persistent file handle, if any
+            if(h5pp::counter::ActiveFileCounter::getCount() == 1) { h5pp::type::registry::closeTypes(); }
             h5pp::counter::ActiveFileCounter::decrementCounter(fileName.string());
             if(h5pp::counter::ActiveFileCounter::getCount() == 0) {
-                h5pp::logger::log->debug("Closing file: {}.", fileName.string(), h5pp::counter::ActiveFileCounter::getCount(), h5pp::counter::ActiveFileCounter::OpenFileNames());
+                H5PP_DEBUG("Closing file: {}.", fileName.string(), h5pp::counter::ActiveFileCounter::getCount(), h5pp::counter::ActiveFileCounter::OpenFileNames());
             } else {
-                h5pp::logger::log->debug("Closing file: {}. There are still {} files open: {}",
-                                         getFileName(),
-                                         h5pp::counter::ActiveFileCounter::getCount(),
-                                         h5pp::counter::ActiveFileCounter::OpenFileNames());
+                H5PP_DEBUG("Closing file: {}. There are still {} files open: {}",
+                           getFileName(),
+                           h5pp::counter::ActiveFileCounter::getCount(),
+                           h5pp::counter::ActiveFileCounter::OpenFileNames());
             }
             H5Eprint(H5E_DEFAULT, stderr);
-            h5pp::logger::setLogger(savedLog, logLevel, logTimestamp);
         }
 
         File &operator=(const File &other) {
-            h5pp::logger::log->debug("Assign-constructing this file [{}] from given file: [{}]. Previously initialized (this): {}. Previously initialized (other): {}",
-                                     fileName.string(),
-                                     other.getFileName(),
-                                     hasInitialized,
-                                     other.hasInitialized);
+            auto lock = lockCall();
+            H5PP_DEBUG("Assign-constructing this file [{}] from given file: [{}]. Previously initialized (this): {}. Previously initialized (other): {}",
+                       fileName.string(),
+                       other.getFileName(),
+                       hasInitialized,
+                       other.hasInitialized);
             if(&other != this) {
                 if(hasInitialized) { h5pp::counter::ActiveFileCounter::decrementCounter(fileName.string()); }
+                fileHandle = hid::h5f(); // Drop the persistent file handle, if any
+                linkCache.clear();
                 if(other.hasInitialized) {
-                    logLevel = other.logLevel;
-                    h5pp::logger::setLogger("h5pp", logLevel, logTimestamp);
-                    accessMode = other.getAccessMode();
-                    createMode = CreateMode::OPEN;
-                    fileName   = other.fileName;
-                    filePath   = other.filePath;
+                    logLevel                = other.logLevel;
+                    logTimestamp            = other.logTimestamp;
+                    accessMode              = other.getAccessMode();
+                    createMode              = CreateMode::OPEN;
+                    fileName                = other.fileName;
+                    filePath                = other.filePath;
+                    keepFileOpen            = other.keepFileOpen;
+                    trustedWrites           = other.trustedWrites;
+                    coreDriver              = other.coreDriver;
+                    plists                  = other.plists;
+                    dsetChunkCaches         = other.dsetChunkCaches;
+                    defaultCompressionLevel = other.defaultCompressionLevel;
+                    defaultFilters          = other.defaultFilters;
+                    defaultChunkBytes       = other.defaultChunkBytes;
+                    asyncQueueDepth         = other.asyncQueueDepth;
+                    // Statistics and pending asynchronous writes belong to the original
+                    // An in-memory file can't be opened again by name, so the copy shares its handle, and thereby its contents
+                    if(coreDriver) fileHandle = other.fileHandle;
                     initialize();
                 }
             }
             return *this;
         }
 
+        /*! The property lists to use for a given dataset: the file-wide ones, with the settings of the dataset applied if it has any */
+        [[nodiscard]] PropertyLists getPropertyLists(std::string_view dsetName) const {
+            if(dsetChunkCaches.empty()) return plists;
+            auto it = dsetChunkCaches.find(datasetKey(dsetName));
+            if(it == dsetChunkCaches.end()) return plists;
+            PropertyLists dsetPlist = plists;
+            dsetPlist.setDatasetChunkCache(it->second);
+            return dsetPlist;
+        }
+
         [[nodiscard]] hid::h5f openFileHandle() const {
             try {
                 if(hasInitialized) {
+                    auto lock = lockCall();
+                    // In keep-open mode we hand out a new reference to the same handle, which is much cheaper than H5Fopen
+                    if(keepFileOpen and fileHandle.valid()) return fileHandle;
+                    if(coreDriver) throw std::runtime_error("In-memory file has no handle: " + filePath.string());
                     switch(accessMode) {
                         case(AccessMode::READONLY): {
-                            h5pp::logger::log->trace("Opening file handle in READONLY mode");
-                            hid::h5f fileHandle = H5Fopen(filePath.string().c_str(), H5F_ACC_RDONLY, plists.file_access);
-                            if(fileHandle < 0) {
+                            H5PP_TRACE("Opening file handle in READONLY mode");
+                            h5pp::stats::Timer timer(statsPtr(), &h5pp::IoStats::fileOpens);
+                            hid::h5f           handle = H5Fopen(filePath.string().c_str(), H5F_ACC_RDONLY, plists.file_access);
+                            if(handle < 0) {
                                 H5Eprint(H5E_DEFAULT, stderr);
                                 throw std::runtime_error("Failed to open file in read-only mode: " + filePath.string());
                             } else {
-                                return fileHandle;
+                                if(keepFileOpen) fileHandle = handle;
+                                return handle;
                             }
                         }
                         case(AccessMode::READWRITE): {
-                            h5pp::logger::log->trace("Opening file handle in READWRITE mode");
-                            hid::h5f fileHandle = H5Fopen(filePath.string().c_str(), H5F_ACC_RDWR, plists.file_access);
-                            if(fileHandle < 0) {
+                            H5PP_TRACE("Opening file handle in READWRITE mode");
+                            h5pp::stats::Timer timer(statsPtr(), &h5pp::IoStats::fileOpens);
+                            hid::h5f           handle = H5Fopen(filePath.string().c_str(), H5F_ACC_RDWR, plists.file_access);
+                            if(handle < 0) {
                                 H5Eprint(H5E_DEFAULT, stderr);
                                 throw std::runtime_error("Failed to open file in read-write mode: " + filePath.string());
                             } else {
-                                return fileHandle;
+                                if(keepFileOpen) fileHandle = handle;
+                                return handle;
                             }
                         }
                         default: throw std::runtime_error("Invalid access mode");
@@ -160,8 +261,7 @@ namespace h5pp {
         }
 
         void initialize() {
-            auto savedLog = h5pp::logger::log->name();
-            h5pp::logger::setLogger("h5pp|init", logLevel, logTimestamp);
+            h5pp::lock::Guard guard;
             /* Turn off error handling permanently */
             error_stack                          = H5Eget_current_stack();
             herr_t turnOffAutomaticErrorPrinting = H5Eset_auto2(error_stack, nullptr, nullptr);
@@ -171,27 +271,121 @@ namespace h5pp {
                 throw std::runtime_error("Failed to turn off H5E error printing");
             }
 
-            setOutputFilePath();
-            h5pp::type::compound::initTypes();
+            if(not coreDriver) setOutputFilePath();
             //            fileCount++;
             h5pp::counter::ActiveFileCounter::incrementCounter(fileName.string());
-            h5pp::logger::setLogger("h5pp|" + fileName.string(), logLevel, logTimestamp);
-            //            h5pp::Logger::setLogger(savedLog,logLevel,false);
+            // The file may have been renamed, otherwise the logger from the constructor is reused
+            std::string logName = "h5pp|" + fileName.string();
+            if(not fileLog or fileLog->name() != logName) {
+                fileLog = h5pp::logger::createLogger(logName, logLevel, logTimestamp);
+                h5pp::logger::log = fileLog; // The rest of the current call logs to the new logger, until its CallLock restores the previous one
+            } else {
+                h5pp::logger::setLogLevel(fileLog, logLevel);
+            }
             hasInitialized = true;
         }
 
         void setCreateMode(CreateMode createMode_) { createMode = createMode_; }
-        void setAccessMode(AccessMode accessMode_) { accessMode = accessMode_; }
+        void setAccessMode(AccessMode accessMode_) {
+            if(coreDriver and accessMode != accessMode_) throw std::runtime_error("Can't change the access mode of an in-memory file");
+            if(accessMode != accessMode_) close(); // The persistent handle was opened with the old access mode
+            accessMode = accessMode_;
+        }
+
+        /*! Keep the file open between calls.
+         *  By default every call opens and closes the file, which is safe but slow when making many small reads/writes.
+         *  When enabled, a single file handle is kept open until close() is called, or until this object is destroyed.
+         *  Call flush() to make sure that data reaches the disk while the file is kept open.
+         *  Links found or created while the file is kept open are remembered, so that repeated calls on the same paths skip the link lookups.
+         *  Call close() if links are deleted from the file by other means than h5pp.
+         *  In-memory files are always kept open.
+         */
+        void setKeepFileOpen(bool keepFileOpen_ = true) {
+            keepFileOpen = keepFileOpen_ or coreDriver;
+            if(not keepFileOpen) close();
+        }
+
+        /*! Flush buffered data in the persistent file handle to disk. Has no effect when the file is not kept open */
+        void flush() {
+            auto lock = lockCall();
+            if(not fileHandle.valid()) return;
+            H5PP_TRACE("Flushing file: [{}]", filePath.string());
+            herr_t err = H5Fflush(fileHandle, H5F_SCOPE_GLOBAL);
+            if(err < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to flush file: " + filePath.string());
+            }
+        }
+
+        /*! Set the default chunk cache for all datasets in this file.
+         *  Applies to datasets opened after this call. The cache is per open dataset, so it is only reused between reads in keep-open mode or through dataset handles.
+         */
+        void setChunkCache(const ChunkCache &cache) {
+            plists.setChunkCache(cache);
+            close(); // The cache settings of the file access property list take effect when the file is opened again
+        }
+
+        /*! Set the chunk cache for a single dataset, overriding the file-wide default */
+        void setChunkCache(const ChunkCache &cache, std::string_view dsetName) { dsetChunkCaches[datasetKey(dsetName)] = cache; }
+
+        /*! Set the chunk cache for a single existing dataset, sized from its chunk dimensions with h5pp::utils::getDefaultChunkCache */
+        void setChunkCache(std::string_view dsetName) {
+            auto     lock      = lockCall();
+            hid::h5f file      = openFileHandle();
+            auto     dsetProps = getDatasetProperties_read(file, dsetName, plists);
+            if(not dsetProps.dsetExists.value()) throw std::runtime_error("Could not set chunk cache: Dataset does not exist: [" + std::string(dsetName) + "]");
+            setChunkCache(h5pp::utils::getDefaultChunkCache(dsetProps.dims.value(), dsetProps.chunkDims.value(), H5Tget_size(dsetProps.dataType)), dsetName);
+        }
+
+        /*! Decompress the chunks of whole-dataset reads on this many threads, while the raw chunks are read from disk on the calling thread.
+         *  Applies to chunked datasets whose filters h5pp can undo itself (deflate and shuffle), that are read into a container of
+         *  the same type as on file. Other reads are left to HDF5, which decompresses on one thread. The default, 1, leaves all reads to HDF5 */
+        void setReadThreads(size_t threads) {
+            if(threads == 0) throw std::runtime_error("The number of read threads must be positive");
+            plists.readThreads = threads;
+        }
+        [[nodiscard]] size_t getReadThreads() const { return plists.readThreads; }
+
+        /*! Compress the chunks of whole-dataset writes on this many threads, while the compressed chunks are written to disk on the calling thread.
+         *  Applies to chunked datasets whose filters h5pp can apply itself (deflate and shuffle), written in full from a container of
+         *  the same type as on file, without a user-defined fill value. Other writes are left to HDF5. The default, 1, leaves all writes to HDF5 */
+        void setWriteThreads(size_t threads) {
+            if(threads == 0) throw std::runtime_error("The number of write threads must be positive");
+            plists.writeThreads = threads;
+        }
+        [[nodiscard]] size_t getWriteThreads() const { return plists.writeThreads; }
+
+        /*! Close the persistent file handle, if any, and forget the links found so far. In keep-open mode the file is opened again on the next call.
+         *  The handle of an in-memory file stays open, since closing it would discard the file */
+        void close() {
+            auto lock = lockCall();
+            linkCache.clear();
+            if(coreDriver or not fileHandle.valid()) return;
+            H5PP_TRACE("Closing persistent file handle: [{}]", filePath.string());
+            fileHandle = hid::h5f();
+        }
 
         // Functions for querying the file
         [[nodiscard]] CreateMode  getCreateMode() const { return createMode; }
         [[nodiscard]] AccessMode  getAccessMode() const { return accessMode; }
         [[nodiscard]] std::string getFileName() const { return fileName.string(); }
         [[nodiscard]] std::string getFilePath() const { return filePath.string(); }
+        [[nodiscard]] bool        getKeepFileOpen() const { return keepFileOpen; }
+        [[nodiscard]] bool        isInMemory() const { return coreDriver; }
+
+        /*! A copy of the whole file as bytes, e.g. to send over a network or to store in a database. Open it again with fromBuffer.
+         *  Works for files on disk too */
+        [[nodiscard]] std::vector<std::byte> toBuffer() const {
+            auto     lock = lockCall();
+            hid::h5f file = openFileHandle();
+            return h5pp::hdf5::getFileImage(file);
+        }
 
         void setLogLevel(size_t logLevelZeroToFive) {
             logLevel = logLevelZeroToFive;
-            h5pp::logger::setLogLevel(logLevelZeroToFive);
+            if(not fileLog) return;
+            h5pp::lock::Guard guard;
+            h5pp::logger::setLogLevel(fileLog, logLevelZeroToFive);
         }
 
         // Functions related to datasets
@@ -199,6 +393,49 @@ namespace h5pp {
         void setDefaultCompressionLevel(unsigned int compressionLevelZeroToNine) { defaultCompressionLevel = h5pp::hdf5::getValidCompressionLevel(compressionLevelZeroToNine); }
         [[nodiscard]] unsigned int getDefaultCompressionLevel() const { return defaultCompressionLevel; }
 
+        /*! Set the target size in bytes of automatically chosen chunk dimensions. Values between 64 KiB and 1 MiB work well in most cases.
+         *  Chunks are never made larger than the chunk cache, see setChunkCache */
+        void setDefaultChunkBytes(size_t chunkBytes) {
+            if(chunkBytes == 0) throw std::runtime_error("The target chunk size must be positive");
+            defaultChunkBytes = chunkBytes;
+        }
+        [[nodiscard]] size_t getDefaultChunkBytes() const { return defaultChunkBytes; }
+
+        /*! In trusted mode, writing into existing datasets and attributes skips checking that the C++ type matches the type on file.
+         *  Use it in hot loops that are known to write the same types over and over. A mismatch is then only caught if the sizes differ,
+         *  otherwise HDF5 converts the data if it can. Outside trusted mode, each pair of C++ type and compound type on file is compared once per process */
+        void               setTrustedWrites(bool trustedWrites_ = true) { trustedWrites = trustedWrites_; }
+        [[nodiscard]] bool getTrustedWrites() const { return trustedWrites; }
+
+        /*! Collect counts, times and bytes of file opens, property scans, dataset creates, reads, writes and layout conversions in this file.
+         *  When disabled, the statistics are dropped, and the calls pay only for a few checks of a null pointer */
+        void setCollectStats(bool collectStats = true) {
+            if(not collectStats)
+                stats = std::nullopt;
+            else if(not stats)
+                stats = IoStats();
+        }
+        [[nodiscard]] bool getCollectStats() const { return stats.has_value(); }
+
+        /*! The statistics collected so far. Throws if they are not being collected */
+        [[nodiscard]] IoStats getStats() const {
+            auto lock = lockCall();
+            if(not stats) throw std::runtime_error("Statistics are not collected for file: " + filePath.string() + ". Enable with setCollectStats()");
+            IoStats current = stats.value();
+            double  hitRate = 0;
+            if(fileHandle.valid() and H5Fget_mdc_hit_rate(fileHandle, &hitRate) >= 0) current.metadataCacheHitRate = hitRate;
+            return current;
+        }
+        void resetStats() {
+            auto lock = lockCall();
+            if(stats) stats = IoStats();
+        }
+
+        /*! Set a filter pipeline for new chunked datasets, e.g. {h5pp::filter::shuffle(), h5pp::filter::deflate(6)}.
+         *  When a pipeline is used, the default compression level is ignored, so the pipeline describes all the filters of the dataset */
+        void                                    setDefaultFilters(const std::vector<Filter> &filters) { defaultFilters = filters; }
+        [[nodiscard]] const std::vector<Filter> &getDefaultFilters() const { return defaultFilters; }
+
         template<typename DataType>
         void writeDataset(const DataType &data, const DatasetProperties &dsetProps);
 
@@ -207,7 +444,8 @@ namespace h5pp {
                           std::string_view                    dsetName,
                           std::optional<H5D_layout_t>         layout           = std::nullopt,
                           std::optional<std::vector<hsize_t>> chunkDimensions  = std::nullopt,
-                          std::optional<unsigned int>         compressionLevel = std::nullopt);
+                          std::optional<unsigned int>         compressionLevel = std::nullopt,
+                          std::optional<std::vector<Filter>>  filters          = std::nullopt);
 
         template<typename PointerType, typename T, size_t N, typename... Args, typename = std::enable_if_t<std::is_pointer_v<PointerType> and std::is_integral_v<T>>>
         void writeDataset(const PointerType ptr,
@@ -215,8 +453,9 @@ namespace h5pp {
                           std::string_view                    datasetPath,
                           std::optional<H5D_layout_t>         layout           = std::nullopt,
                           std::optional<std::vector<hsize_t>> chunkDimensions  = std::nullopt,
-                          std::optional<unsigned int>         compressionLevel = std::nullopt) {
-            writeDataset(h5pp::PtrWrapper(ptr, dims), datasetPath, layout, chunkDimensions, compressionLevel);
+                          std::optional<unsigned int>         compressionLevel = std::nullopt,
+                          std::optional<std::vector<Filter>>  filters          = std::nullopt) {
+            writeDataset(h5pp::PtrWrapper(ptr, dims), datasetPath, layout, chunkDimensions, compressionLevel, filters);
         }
 
         template<typename PointerType, typename = std::enable_if_t<std::is_pointer_v<PointerType>>>
@@ -225,15 +464,57 @@ namespace h5pp {
                           std::string_view                    datasetPath,
                           std::optional<H5D_layout_t>         layout           = std::nullopt,
                           std::optional<std::vector<hsize_t>> chunkDimensions  = std::nullopt,
-                          std::optional<unsigned int>         compressionLevel = std::nullopt) {
-            writeDataset(h5pp::PtrWrapper(ptr, size), datasetPath, layout, chunkDimensions, compressionLevel);
+                          std::optional<unsigned int>         compressionLevel = std::nullopt,
+                          std::optional<std::vector<Filter>>  filters          = std::nullopt) {
+            writeDataset(h5pp::PtrWrapper(ptr, size), datasetPath, layout, chunkDimensions, compressionLevel, filters);
+        }
+
+        /*! Write data into the sub-region (hyperslab) of an existing dataset starting at offset, with an optional stride.
+         *  The extent of the region is given by the dimensions of the data. Chunked datasets grow to fit the region if needed.
+         */
+        template<typename DataType>
+        void writeDataset(const DataType &data, std::string_view dsetName, const std::vector<hsize_t> &offset, const std::optional<std::vector<hsize_t>> &stride = std::nullopt);
+
+        template<typename DataType>
+        void appendToDataset(const DataType &data, std::string_view dsetName, size_t axis = 0);
+
+        /*! Write a dataset on a background thread, and return at once. The future becomes ready when the write is done, and rethrows its errors.
+         *  Data given as an rvalue is moved, otherwise it is copied into a staging buffer that is reused by later writes of the same type.
+         *  Views, such as pointers or Eigen maps, are not accepted, since the data they point to may change before it is written.
+         *  Writes are done in order, and block when setAsyncQueueDepth writes are already waiting.
+         *  Every other call on this file waits for pending asynchronous writes first, so that HDF5 is only called from one thread at a time.
+         */
+        template<typename DataType>
+        [[nodiscard]] std::future<void> writeDatasetAsync(DataType &&                         data,
+                                                          std::string_view                    dsetName,
+                                                          std::optional<H5D_layout_t>         layout           = std::nullopt,
+                                                          std::optional<std::vector<hsize_t>> chunkDimensions  = std::nullopt,
+                                                          std::optional<unsigned int>         compressionLevel = std::nullopt,
+                                                          std::optional<std::vector<Filter>>  filters          = std::nullopt);
+
+        /*! Start collecting writes of many small datasets and attributes, which are written together by WriteBatch::commit */
+        [[nodiscard]] WriteBatch beginBatch();
+
+        /*! Block until all asynchronous writes are done */
+        void waitAsync() const {
+            if(hasAsyncQueue.load(std::memory_order_acquire)) asyncQueue->wait();
         }
 
+        /*! Set the number of asynchronous writes that may wait in the queue before writeDatasetAsync blocks */
+        void setAsyncQueueDepth(size_t depth) {
+            if(depth == 0) throw std::runtime_error("The depth of the asynchronous write queue must be positive");
+            asyncQueueDepth = depth;
+            if(asyncQueue) asyncQueue->setMaxDepth(depth);
+        }
+        [[nodiscard]] size_t getAsyncQueueDepth() const { return asyncQueueDepth; }
+
         template<typename DataType, typename = std::enable_if_t<not std::is_const_v<DataType>>>
         void readDataset(DataType &data, std::string_view dsetName) const {
+            auto     lock      = lockCall();
+            auto     scope     = statsScope();
             hid::h5f file      = openFileHandle();
-            auto     dsetProps = h5pp::scan::getDatasetProperties_read(file, dsetName, std::nullopt, plists);
-            h5pp::hdf5::readDataset(data, dsetProps);
+            auto     dsetProps = getDatasetProperties_read(file, dsetName, getPropertyLists(dsetName));
+            h5pp::hdf5::readDataset(data, dsetProps, plists);
         }
 
         template<typename PointerType, typename T, size_t N, typename = std::enable_if_t<std::is_array_v<PointerType> or std::is_pointer_v<PointerType>>>
@@ -255,6 +536,86 @@ namespace h5pp {
             return data;
         }
 
+        /*! Read the sub-region (hyperslab) of a dataset starting at offset, with extent elements along each dimension.
+         *  An optional stride selects every n'th element. Only the selected elements are read from file.
+         */
+        template<typename DataType, typename = std::enable_if_t<not std::is_const_v<DataType> and not std::is_pointer_v<DataType> and not std::is_array_v<DataType>>>
+        void readDataset(DataType &                                 data,
+                         std::string_view                           dsetName,
+                         const std::vector<hsize_t> &               offset,
+                         const std::vector<hsize_t> &               extent,
+                         const std::optional<std::vector<hsize_t>> &stride = std::nullopt) const {
+            auto     lock      = lockCall();
+            auto     scope     = statsScope();
+            hid::h5f file      = openFileHandle();
+            auto     dsetProps = getDatasetProperties_read(file, dsetName, getPropertyLists(dsetName));
+            h5pp::hdf5::readDataset(data, dsetProps, offset, extent, stride, plists);
+        }
+
+        template<typename PointerType, typename = std::enable_if_t<std::is_array_v<PointerType> or std::is_pointer_v<PointerType>>>
+        void readDataset(PointerType                                ptr,
+                         std::string_view                           dsetName,
+                         const std::vector<hsize_t> &               offset,
+                         const std::vector<hsize_t> &               extent,
+                         const std::optional<std::vector<hsize_t>> &stride = std::nullopt) const {
+            auto wrapper = h5pp::PtrWrapper(ptr, std::accumulate(extent.begin(), extent.end(), (size_t) 1, std::multiplies<>()));
+            readDataset(wrapper, dsetName, offset, extent, stride);
+        }
+
+        template<typename DataType, typename = std::enable_if_t<not std::is_const_v<DataType>>>
+        DataType readDataset(std::string_view                           datasetPath,
+                             const std::vector<hsize_t> &               offset,
+                             const std::vector<hsize_t> &               extent,
+                             const std::optional<std::vector<hsize_t>> &stride = std::nullopt) const {
+            DataType data;
+            readDataset(data, datasetPath, offset, extent, stride);
+            return data;
+        }
+
+#ifdef H5PP_EIGEN3
+        /*! Read a sub-region of a two-dimensional dataset, starting at offset, into a block of an existing matrix, e.g. matrix.block(i,j,rows,cols) */
+        template<typename XprType, int BlockRows, int BlockCols, bool InnerPanel>
+        void readDataset(Eigen::Block<XprType, BlockRows, BlockCols, InnerPanel> block,
+                         std::string_view                                        dsetName,
+                         const std::vector<hsize_t> &                            offset,
+                         const std::optional<std::vector<hsize_t>> &             stride = std::nullopt) const {
+            auto     lock      = lockCall();
+            auto     scope     = statsScope();
+            hid::h5f file      = openFileHandle();
+            auto     dsetProps = getDatasetProperties_read(file, dsetName, getPropertyLists(dsetName));
+            h5pp::hdf5::readDataset(block, dsetProps, offset, stride, plists);
+        }
+#endif
+
+        /*! Open a handle to an existing dataset.
+         *  The handle caches the dataset properties so that repeated reads and writes skip the lookups done by readDataset/writeDataset.
+         *  Note that the handle keeps the file open for as long as it exists.
+         *  A chunk cache given here applies to this handle only, and overrides any cache set with setChunkCache.
+         */
+        [[nodiscard]] Dataset openDataset(std::string_view datasetPath, const std::optional<ChunkCache> &chunkCache = std::nullopt) const {
+            auto     lock = lockCall();
+            hid::h5f file = openFileHandle();
+            if(not chunkCache) return Dataset(file, datasetPath, getPropertyLists(datasetPath));
+            PropertyLists handlePlists = getPropertyLists(datasetPath);
+            handlePlists.setDatasetChunkCache(chunkCache.value());
+            return Dataset(file, datasetPath, handlePlists);
+        }
+
+        /*! A read-only view of a whole dataset, mapped from disk without copying when possible, see MappedDataset.
+         *  Mapping requires a contiguous dataset, which has no filters, stored by the default (sec2) driver in a type identical to DataType.
+         *  The data must also be aligned for DataType in the file, which can be guaranteed with H5Pset_alignment on plists.file_access.
+         *  Other datasets are read into the view instead */
+        template<typename DataType>
+        [[nodiscard]] MappedDataset<DataType> mapDataset(std::string_view dsetName) const;
+
+        /*! A range over successive blocks of blockRows rows of a dataset, along its leading dimension, see DatasetBlocks.
+         *  Use it to process datasets larger than memory: for(auto &block : file.iterateDataset<std::vector<double>>("big", 1024)).
+         *  With a readAhead depth, up to that many of the following blocks are read on a background thread while the current one is processed */
+        template<typename DataType>
+        [[nodiscard]] DatasetBlocks<DataType> iterateDataset(std::string_view dsetName, hsize_t blockRows, size_t readAhead = 0) const {
+            return DatasetBlocks<DataType>(openDataset(dsetName), blockRows, readAhead);
+        }
+
         // Functions related to attributes
         template<typename DataType>
         void writeAttribute(const DataType &attribute, const AttributeProperties &aprops);
@@ -263,15 +624,21 @@ namespace h5pp {
         void writeAttribute(const DataType &data, std::string_view attrName, std::string_view linkName);
 
         [[nodiscard]] inline std::vector<std::string> getAttributeNames(std::string_view linkPath) const {
+            auto                     lock           = lockCall();
             hid::h5f                 file           = openFileHandle();
-            std::vector<std::string> attributeNames = h5pp::hdf5::getAttributeNames(file, linkPath, std::nullopt, plists);
+            std::vector<std::string> attributeNames = h5pp::hdf5::getAttributeNames(file, linkPath, cachedLinkExists(linkPath), plists);
             return attributeNames;
         }
 
         template<typename DataType, typename = std::enable_if_t<not std::is_const_v<DataType>>>
         void readAttribute(DataType &data, std::string_view attrName, std::string_view linkName) const {
-            hid::h5f file      = openFileHandle();
-            auto     attrProps = h5pp::scan::getAttributeProperties_read(file, attrName, linkName, std::nullopt, std::nullopt, plists);
+            auto               lock  = lockCall();
+            auto               scope = statsScope();
+            hid::h5f           file  = openFileHandle();
+            h5pp::stats::Timer scan(statsPtr(), &h5pp::IoStats::propertyScans);
+            auto               attrProps = h5pp::scan::getAttributeProperties_read(file, attrName, linkName, std::nullopt, cachedLinkExists(linkName), plists);
+            scan.stop();
+            h5pp::stats::Timer timer(statsPtr(), &h5pp::IoStats::attributeReads, attrProps.bytes.value_or(0));
             h5pp::hdf5::readAttribute(data, attrProps);
         }
 
@@ -285,51 +652,154 @@ namespace h5pp {
         // Functions for querying
 
         [[nodiscard]] int getDatasetRank(std::string_view datasetPath) {
+            auto     lock    = lockCall();
             hid::h5f file    = openFileHandle();
-            hid::h5d dataset = h5pp::hdf5::openObject<hid::h5d>(file, datasetPath);
+            hid::h5d dataset = h5pp::hdf5::openObject<hid::h5d>(file, datasetPath, cachedLinkExists(datasetPath));
             return h5pp::hdf5::getRank(dataset);
         }
 
         [[nodiscard]] std::vector<hsize_t> getDatasetDimensions(std::string_view datasetPath) {
+            auto     lock    = lockCall();
             hid::h5f file    = openFileHandle();
-            hid::h5d dataset = h5pp::hdf5::openObject<hid::h5d>(file, datasetPath);
+            hid::h5d dataset = h5pp::hdf5::openObject<hid::h5d>(file, datasetPath, cachedLinkExists(datasetPath));
             return h5pp::hdf5::getDimensions(dataset);
         }
 
         [[nodiscard]] bool linkExists(std::string_view link) const {
+            // Links known to exist are answered without waiting for the HDF5 lock
+            if(auto cached = cachedLinkExists(link)) return cached.value();
+            auto     lock   = lockCall();
             hid::h5f file   = openFileHandle();
             bool     exists = h5pp::hdf5::checkIfLinkExists(file, link, std::nullopt, plists);
+            if(exists) cacheLink(link, H5O_TYPE_UNKNOWN);
             return exists;
         }
 
         [[nodiscard]] std::vector<std::string> getContentsOfGroup(std::string_view groupName) const {
+            auto     lock       = lockCall();
             hid::h5f file       = openFileHandle();
             auto     foundLinks = h5pp::hdf5::getContentsOfGroup(file, groupName);
             return foundLinks;
         }
 
-        [[nodiscard]] bool fileIsValid() const { return h5pp::hdf5::fileIsValid(filePath); }
+        [[nodiscard]] bool fileIsValid() const {
+            auto lock = lockCall();
+            if(coreDriver) return fileHandle.valid();
+            return h5pp::hdf5::fileIsValid(filePath);
+        }
 
         void createGroup(std::string_view group_relative_name) {
+            auto     lock = lockCall();
             hid::h5f file = openFileHandle();
-            h5pp::hdf5::createGroup(file, group_relative_name, std::nullopt, plists);
+            h5pp::hdf5::createGroup(file, group_relative_name, cachedLinkExists(group_relative_name), plists);
+            cacheLink(group_relative_name, H5O_TYPE_GROUP);
         }
 
         void writeSymbolicLink(std::string_view src_path, std::string_view tgt_path) {
+            auto     lock = lockCall();
             hid::h5f file = openFileHandle();
             h5pp::hdf5::writeSymbolicLink(file, src_path, tgt_path, plists);
+            cacheLink(tgt_path, H5O_TYPE_UNKNOWN);
         }
         void createDataset(DatasetProperties &dsetProps) {
+            auto lock  = lockCall();
+            auto scope = statsScope();
             if(not dsetProps.dsetExists) {
-                h5pp::logger::log->trace("Creating dataset: [{}]", dsetProps.dsetName.value());
+                H5PP_TRACE("Creating dataset: [{}]", dsetProps.dsetName.value());
                 hid::h5f file = openFileHandle();
                 h5pp::hdf5::createDataset(file, dsetProps, plists);
+                cacheLink(dsetProps.dsetName.value(), H5O_TYPE_DATASET);
             }
         }
 
         private:
+        friend class WriteBatch;
+
+        /*! Wraps an open in-memory file, see inMemory and fromBuffer */
+        File(fs::path filePath_, hid::h5f handle, AccessMode accessMode_, PropertyLists plists_, size_t logLevel_, bool logTimestamp_)
+            : fileName(filePath_.filename()), filePath(std::move(filePath_)), accessMode(accessMode_), createMode(CreateMode::OPEN), logLevel(logLevel_),
+              logTimestamp(logTimestamp_), keepFileOpen(true), fileHandle(std::move(handle)), coreDriver(true), plists(std::move(plists_)) {
+            fileLog   = h5pp::logger::createLogger("h5pp|" + fileName.string(), logLevel, logTimestamp);
+            auto lock = lockCall();
+            H5PP_DEBUG("Constructing in-memory h5pp file: [{}]", filePath.string());
+            initialize();
+        }
+
+        /*! The body of writeDataset, on an open file, with what the caller already knows about the dataset. A given creation property list is reused if the layout allows */
+        template<typename DataType>
+        DatasetProperties writeDatasetToHandle(hid::h5f &                          file,
+                                               const DataType &                    data,
+                                               std::string_view                    dsetName,
+                                               std::optional<bool>                 dsetExists,
+                                               std::optional<H5D_layout_t>         layout,
+                                               std::optional<std::vector<hsize_t>> chunkDimensions,
+                                               std::optional<unsigned int>         compressionLevel,
+                                               std::optional<std::vector<Filter>>  filters,
+                                               const std::optional<hid::h5p> &     dsetCreatePlist = std::nullopt);
+
+        /*! The body of writeAttribute, on an open file */
+        template<typename DataType>
+        void writeAttributeToHandle(hid::h5f &file, const DataType &data, std::string_view attrName, std::string_view linkName, std::optional<bool> linkExists);
+
+        /*! The path of a dataset relative to the root group, without empty or "." components, so that e.g. "/a//b" and "a/./b" name the same dataset */
+        [[nodiscard]] static std::string datasetKey(std::string_view dsetName) {
+            std::string key;
+            while(not dsetName.empty()) {
+                auto pos       = dsetName.find('/');
+                auto component = dsetName.substr(0, pos);
+                dsetName       = pos == std::string_view::npos ? std::string_view() : dsetName.substr(pos + 1);
+                if(component.empty() or component == ".") continue;
+                if(not key.empty()) key += '/';
+                key += component;
+            }
+            return key;
+        }
+
+        [[nodiscard]] std::optional<bool> cachedLinkExists(std::string_view linkName) const { return keepFileOpen ? linkCache.linkExists(linkName) : std::nullopt; }
+        [[nodiscard]] std::optional<bool> cachedDsetExists(std::string_view dsetName) const { return keepFileOpen ? linkCache.dsetExists(dsetName) : std::nullopt; }
+        [[nodiscard]] std::optional<bool> trustedTypes() const { return trustedWrites ? std::optional<bool>(true) : std::nullopt; }
+        void                              cacheLink(std::string_view linkName, H5O_type_t linkType) const {
+            if(keepFileOpen) linkCache.insert(linkName, linkType);
+        }
+
+        /*! Holds the HDF5 lock during one call on this file, with the global logger pointing to the logger of this file.
+         *  The previous logger is restored when the call ends, so nested calls, e.g. on a File made during a call, restore the outer one */
+        class CallLock {
+            private:
+            h5pp::lock::Guard           guard;
+            decltype(h5pp::logger::log) previousLog;
+
+            public:
+            explicit CallLock(const decltype(h5pp::logger::log) &fileLog_) : previousLog(h5pp::logger::log) {
+                if(fileLog_) h5pp::logger::log = fileLog_;
+            }
+            ~CallLock() { h5pp::logger::log = std::move(previousLog); }
+            CallLock(const CallLock &) = delete;
+            CallLock &operator=(const CallLock &) = delete;
+        };
+
+        [[nodiscard]] CallLock lockCall() const {
+            waitAsyncFromCaller();
+            return CallLock(fileLog);
+        }
+
+        void waitAsyncFromCaller() const {
+            // The background thread must not wait for itself, and a thread holding the lock must not wait for writes that need it
+            if(hasAsyncQueue.load(std::memory_order_acquire) and not asyncQueue->isWorkerThread() and not h5pp::lock::isHeld()) asyncQueue->wait();
+        }
+
+        [[nodiscard]] IoStats *          statsPtr() const { return stats ? &stats.value() : nullptr; }
+        [[nodiscard]] h5pp::stats::Scope statsScope() const { return h5pp::stats::Scope(statsPtr()); }
+
+        [[nodiscard]] DatasetProperties getDatasetProperties_read(const hid::h5f &file, std::string_view dsetName, const PropertyLists &dsetPlist) const {
+            h5pp::stats::Timer timer(statsPtr(), &h5pp::IoStats::propertyScans);
+            auto               dsetProps = h5pp::scan::getDatasetProperties_read(file, dsetName, cachedDsetExists(dsetName), dsetPlist);
+            if(dsetProps.dsetExists.value()) cacheLink(dsetName, H5O_TYPE_DATASET);
+            return dsetProps;
+        }
+
         void setOutputFilePath() {
-            h5pp::logger::log->trace("Attempting to set file name and path. File name [{}] path [{}]. Has initialized: {}", fileName.string(), filePath.string(), hasInitialized);
+            H5PP_TRACE("Attempting to set file name and path. File name [{}] path [{}]. Has initialized: {}", fileName.string(), filePath.string(), hasInitialized);
 
             // There are different possibilities:
             // 1) File is being initialized from another h5pp File (e.g. by copy or assignment) In that case the following applies:
@@ -341,23 +811,57 @@ namespace h5pp {
 
             // Take case 2 first and make it into a case 1
             if(filePath.empty()) {
-                h5pp::logger::log->trace("File path empty. Detecting path...");
+                H5PP_TRACE("File path empty. Detecting path...");
                 filePath = fs::absolute(fileName);
                 fileName = filePath.filename();
             }
 
             // Now we expect case 1 to hold.
-            h5pp::logger::log->trace("Current path        : {}", fs::current_path().string());
-            h5pp::logger::log->debug("Detected file name  : {}", fileName.string());
-            h5pp::logger::log->debug("Detected file path  : {}", filePath.string());
+            H5PP_TRACE("Current path        : {}", fs::current_path().string());
+            H5PP_DEBUG("Detected file name  : {}", fileName.string());
+            H5PP_DEBUG("Detected file path  : {}", filePath.string());
             // The following function can modify the resulting filePath and fileName depending on accessmode/createmode.
             std::tie(filePath, fileName) = h5pp::hdf5::createFile(filePath, accessMode, createMode, plists);
         }
     };
 }
 
+template<typename DataType>
+h5pp::MappedDataset<DataType> h5pp::File::mapDataset(std::string_view dsetName) const {
+    static_assert(std::is_trivially_copyable_v<DataType> and not std::is_pointer_v<DataType>, "Only datasets of plain elements can be mapped");
+    auto     lock      = lockCall();
+    auto     scope     = statsScope();
+    hid::h5f file      = openFileHandle();
+    auto     dsetProps = getDatasetProperties_read(file, dsetName, getPropertyLists(dsetName));
+    if(not dsetProps.dsetExists.value()) throw std::runtime_error("Could not map dataset: Dataset does not exist: [" + std::string(dsetName) + "]");
+    auto dims = dsetProps.dims.value();
+    if(not coreDriver and dsetProps.layout.value() == H5D_CONTIGUOUS and H5Tget_size(dsetProps.dataType) == sizeof(DataType) and
+       h5pp::hdf5::checkIfTypesMatch<DataType>(dsetProps.dataType)) {
+        hid::h5p fileAccess = H5Fget_access_plist(file);
+        haddr_t  offset     = H5Dget_offset(dsetProps.dataSet); // Undefined until the dataset has been written
+        if(H5Pget_driver(fileAccess) == H5FD_SEC2 and offset != HADDR_UNDEF) {
+            // Data written in keep-open mode may still be buffered by HDF5
+            if(fileHandle.valid() and accessMode == AccessMode::READWRITE and H5Fflush(file, H5F_SCOPE_LOCAL) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to flush file before mapping dataset: [" + std::string(dsetName) + "]");
+            }
+            if(auto view = MappedDataset<DataType>::tryMap(filePath, offset, dims)) {
+                H5PP_DEBUG("Mapped dataset: [{}] | offset {} | dims {}", dsetName, offset, dims);
+                return std::move(view.value());
+            }
+        }
+    }
+    H5PP_DEBUG("Could not map dataset: [{}]. Reading it instead", dsetName);
+    // Read through a wrapper, since std::vector only reads one-dimensional datasets
+    std::vector<DataType> data(dsetProps.size.value());
+    auto                  wrapper = h5pp::PtrWrapper(data.data(), data.size());
+    h5pp::hdf5::readDataset(wrapper, dsetProps, plists);
+    return MappedDataset<DataType>(std::move(data), std::move(dims));
+}
+
 template<typename DataType>
 void h5pp::File::writeDataset(const DataType &data, const DatasetProperties &dsetProps) {
+    auto     lock = lockCall();
     hid::h5f file = openFileHandle();
     h5pp::hdf5::writeDataset(data, dsetProps, plists);
 }
@@ -367,40 +871,135 @@ void h5pp::File::writeDataset(const DataType &                    data,
                               std::string_view                    dsetName,
                               std::optional<H5D_layout_t>         layout,
                               std::optional<std::vector<hsize_t>> chunkDimensions,
-                              std::optional<unsigned int>         compressionLevel) {
+                              std::optional<unsigned int>         compressionLevel,
+                              std::optional<std::vector<Filter>>  filters) {
     if(accessMode == AccessMode::READONLY) { throw std::runtime_error("Attempted to write to read-only file"); }
-    hid::h5f file = openFileHandle();
+    auto     lock  = lockCall();
+    auto     scope = statsScope();
+    hid::h5f file  = openFileHandle();
+    writeDatasetToHandle(file, data, dsetName, cachedLinkExists(dsetName), layout, chunkDimensions, compressionLevel, filters);
+}
 
+template<typename DataType>
+h5pp::DatasetProperties h5pp::File::writeDatasetToHandle(hid::h5f &                          file,
+                                                         const DataType &                    data,
+                                                         std::string_view                    dsetName,
+                                                         std::optional<bool>                 dsetExists,
+                                                         std::optional<H5D_layout_t>         layout,
+                                                         std::optional<std::vector<hsize_t>> chunkDimensions,
+                                                         std::optional<unsigned int>         compressionLevel,
+                                                         std::optional<std::vector<Filter>>  filters,
+                                                         const std::optional<hid::h5p> &     dsetCreatePlist) {
+    if(not filters and not defaultFilters.empty()) filters = defaultFilters;
     if(compressionLevel)
         compressionLevel = h5pp::hdf5::getValidCompressionLevel(compressionLevel);
+    else if(filters)
+        compressionLevel = 0; // The filter pipeline replaces the default compression
     else
         compressionLevel = getDefaultCompressionLevel();
 
-    auto dsetProps = h5pp::scan::getDatasetProperties_write(file, dsetName, data, std::nullopt, layout, chunkDimensions, compressionLevel);
+    const auto &       dsetPlist = getPropertyLists(dsetName);
+    h5pp::stats::Timer scan(statsPtr(), &h5pp::IoStats::propertyScans);
+    auto dsetProps = h5pp::scan::getDatasetProperties_write(file, dsetName, data, dsetExists, layout, chunkDimensions, compressionLevel, filters, defaultChunkBytes, trustedTypes(), dsetCreatePlist, dsetPlist);
+    scan.stop();
     // Create the dataset id and set its properties
-    h5pp::hdf5::createDataset(file, dsetProps);
+    h5pp::hdf5::createDataset(file, dsetProps, dsetPlist);
     h5pp::hdf5::setDatasetExtent(dsetProps);
     dsetProps.fileSpace = H5Dget_space(dsetProps.dataSet);
     if(dsetProps.layout.value() == H5D_CHUNKED) h5pp::hdf5::selectHyperslab(dsetProps.fileSpace, dsetProps.memSpace);
 
     h5pp::hdf5::writeDataset(data, dsetProps, plists);
+    cacheLink(dsetName, H5O_TYPE_DATASET);
+    return dsetProps;
+}
+
+template<typename DataType>
+void h5pp::File::writeDataset(const DataType &data, std::string_view dsetName, const std::vector<hsize_t> &offset, const std::optional<std::vector<hsize_t>> &stride) {
+    if(accessMode == AccessMode::READONLY) { throw std::runtime_error("Attempted to write to read-only file"); }
+    auto               lock  = lockCall();
+    auto               scope = statsScope();
+    hid::h5f           file  = openFileHandle();
+    h5pp::stats::Timer scan(statsPtr(), &h5pp::IoStats::propertyScans);
+    auto               dsetProps = h5pp::scan::getDatasetProperties_modify<DataType>(file, dsetName, cachedDsetExists(dsetName), trustedTypes(), getPropertyLists(dsetName));
+    scan.stop();
+    h5pp::hdf5::writeDataset(data, dsetProps, offset, stride, plists);
+}
+
+template<typename DataType>
+void h5pp::File::appendToDataset(const DataType &data, std::string_view dsetName, size_t axis) {
+    if(accessMode == AccessMode::READONLY) { throw std::runtime_error("Attempted to write to read-only file"); }
+    auto     lock  = lockCall();
+    auto     scope = statsScope();
+    hid::h5f file  = openFileHandle();
+    if(not h5pp::hdf5::checkIfLinkExists(file, dsetName, cachedLinkExists(dsetName), plists)) {
+        // Nothing to append to yet: start a new extendable dataset
+        writeDataset(data, dsetName, H5D_CHUNKED);
+        return;
+    }
+    h5pp::stats::Timer scan(statsPtr(), &h5pp::IoStats::propertyScans);
+    auto               dsetProps = h5pp::scan::getDatasetProperties_modify<DataType>(file, dsetName, cachedDsetExists(dsetName), trustedTypes(), getPropertyLists(dsetName));
+    scan.stop();
+    h5pp::hdf5::appendDataset(data, dsetProps, axis, plists);
+}
+
+template<typename DataType>
+std::future<void> h5pp::File::writeDatasetAsync(DataType &&                         data,
+                                                std::string_view                    dsetName,
+                                                std::optional<H5D_layout_t>         layout,
+                                                std::optional<std::vector<hsize_t>> chunkDimensions,
+                                                std::optional<unsigned int>         compressionLevel,
+                                                std::optional<std::vector<Filter>>  filters) {
+    using StagedType = std::decay_t<DataType>;
+    static_assert(not std::is_pointer_v<StagedType> and not h5pp::type::sfinae::is_ptr_wrapper<StagedType>::value,
+                  "Asynchronous writes need to own their data: pointers can't be written asynchronously");
+#ifdef H5PP_EIGEN3
+    static_assert(not h5pp::type::sfinae::is_eigen_any<StagedType>::value or h5pp::type::sfinae::has_resize<StagedType>::value,
+                  "Asynchronous writes need to own their data: Eigen maps can't be written asynchronously");
+#endif
+    if(accessMode == AccessMode::READONLY) { throw std::runtime_error("Attempted to write to read-only file"); }
+    if(not hasAsyncQueue.load(std::memory_order_acquire)) {
+        h5pp::lock::Guard guard; // Serializes threads starting the queue at the same time
+        if(not asyncQueue) asyncQueue = std::make_unique<AsyncQueue>(asyncQueueDepth);
+        hasAsyncQueue.store(true, std::memory_order_release);
+    }
+    std::shared_ptr<const StagedType> staged;
+    if constexpr(std::is_lvalue_reference_v<DataType>)
+        staged = asyncQueue->stage(data);
+    else
+        staged = std::make_shared<const StagedType>(std::move(data));
+    return asyncQueue->push([this, staged, name = std::string(dsetName), layout, chunkDimensions, compressionLevel, filters]() {
+        writeDataset(*staged, name, layout, chunkDimensions, compressionLevel, filters);
+    });
 }
 
 template<typename DataType>
 void h5pp::File::writeAttribute(const DataType &data, const AttributeProperties &attrProps) {
-    hid::h5f file = openFileHandle();
+    auto               lock  = lockCall();
+    auto               scope = statsScope();
+    hid::h5f           file  = openFileHandle();
+    h5pp::stats::Timer timer(statsPtr(), &h5pp::IoStats::attributeWrites, attrProps.bytes.value_or(0));
     h5pp::hdf5::writeAttribute(data, attrProps);
 }
 
 template<typename DataType>
 void h5pp::File::writeAttribute(const DataType &data, std::string_view attrName, std::string_view linkName) {
-    hid::h5f file      = openFileHandle();
-    auto     attrProps = h5pp::scan::getAttributeProperties_write(file, data, attrName, linkName, std::nullopt, std::nullopt, plists);
+    auto     lock  = lockCall();
+    auto     scope = statsScope();
+    hid::h5f file  = openFileHandle();
+    writeAttributeToHandle(file, data, attrName, linkName, cachedLinkExists(linkName));
+}
+
+template<typename DataType>
+void h5pp::File::writeAttributeToHandle(hid::h5f &file, const DataType &data, std::string_view attrName, std::string_view linkName, std::optional<bool> linkExists) {
+    h5pp::stats::Timer scan(statsPtr(), &h5pp::IoStats::propertyScans);
+    auto               attrProps = h5pp::scan::getAttributeProperties_write(file, data, attrName, linkName, std::nullopt, linkExists, trustedTypes(), plists);
+    scan.stop();
     h5pp::hdf5::createAttribute(attrProps);
+    h5pp::stats::Timer timer(statsPtr(), &h5pp::IoStats::attributeWrites, attrProps.bytes.value_or(0));
 
 #ifdef H5PP_EIGEN3
     if constexpr(h5pp::type::sfinae::is_eigen_any<DataType>::value and not h5pp::type::sfinae::is_eigen_1d<DataType>::value) {
-        h5pp::logger::log->debug("Converting data to row-major storage order");
+        H5PP_DEBUG("Converting data to row-major storage order");
         const auto tempRowm = eigen::to_RowMajor(data); // Convert to Row Major first;
         h5pp::hdf5::writeAttribute(tempRowm, attrProps);
         return;
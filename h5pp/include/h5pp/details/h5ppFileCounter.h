@@ -1,4 +1,5 @@
 #pragma once
+#include "h5ppLock.h"
 #include <algorithm>
 #include <list>
 #include <optional>
@@ -9,19 +10,30 @@ namespace h5pp {
         class ActiveFileCounter {
             public:
             friend class h5pp::File;
-            inline static size_t                 getCount() { return openFiles.size(); }
-            inline static std::list<std::string> getOpenFiles() { return openFiles; }
-            inline static std::string            OpenFileNames() {
-                std::string names;
+            inline static size_t getCount() {
+                h5pp::lock::Guard guard;
+                return openFiles.size();
+            }
+            inline static std::list<std::string> getOpenFiles() {
+                h5pp::lock::Guard guard;
+                return openFiles;
+            }
+            inline static std::string OpenFileNames() {
+                h5pp::lock::Guard guard;
+                std::string       names;
                 for(auto &file : openFiles) { names += file + " "; }
                 return names;
             }
 
             private:
             inline static std::list<std::string> openFiles;
-            inline static void                   incrementCounter(const std::string &fileName) { openFiles.push_front(fileName); }
-            inline static void                   decrementCounter(const std::string &fileName) {
-                auto iter = std::find(openFiles.begin(), openFiles.end(), fileName);
+            inline static void                   incrementCounter(const std::string &fileName) {
+                h5pp::lock::Guard guard;
+                openFiles.push_front(fileName);
+            }
+            inline static void decrementCounter(const std::string &fileName) {
+                h5pp::lock::Guard guard;
+                auto              iter = std::find(openFiles.begin(), openFiles.end(), fileName);
                 if(iter != openFiles.end()) { openFiles.erase(iter); }
             }
         };
@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+/*!
+ * Filters for the HDF5 filter pipeline, applied in order to each chunk of a chunked dataset.
+ * Build a pipeline with the functions in h5pp::filter, e.g.
+ *
+ *      std::vector<h5pp::Filter> filters = {h5pp::filter::shuffle(), h5pp::filter::deflate(6)};
+ *
+ * Plugin filters (zstd, lz4, blosc) are loaded dynamically by HDF5 from HDF5_PLUGIN_PATH,
+ * use h5pp::hdf5::checkIfFilterIsAvailable to check whether they can be used.
+ * */
+namespace h5pp {
+    struct Filter {
+        H5Z_filter_t              id;
+        std::vector<unsigned int> params;                    /*!< Client data values (cd_values) passed to the filter */
+        unsigned int              flags = H5Z_FLAG_OPTIONAL; /*!< With H5Z_FLAG_OPTIONAL the filter is skipped for chunks it fails on, or if it is not available */
+        std::string               name;
+    };
+
+    namespace filter {
+        // Registered identifiers of common plugin filters, see https://portal.hdfgroup.org/display/support/Registered+Filter+Plugins
+        static constexpr H5Z_filter_t H5Z_FILTER_BLOSC = 32001;
+        static constexpr H5Z_filter_t H5Z_FILTER_LZ4   = 32004;
+        static constexpr H5Z_filter_t H5Z_FILTER_ZSTD  = 32015;
+
+        /*! Byte shuffle. Improves the compression ratio of numeric data considerably when placed before a compression filter */
+        inline Filter shuffle() { return Filter{H5Z_FILTER_SHUFFLE, {}, H5Z_FLAG_OPTIONAL, "shuffle"}; }
+
+        /*! Deflate (zlib) compression with level 0 (min) to 9 (max) */
+        inline Filter deflate(unsigned int level = 6) { return Filter{H5Z_FILTER_DEFLATE, {std::min(level, 9u)}, H5Z_FLAG_OPTIONAL, "deflate"}; }
+
+        /*! Fletcher32 checksum. Reads of corrupted chunks fail */
+        inline Filter fletcher32() { return Filter{H5Z_FILTER_FLETCHER32, {}, H5Z_FLAG_MANDATORY, "fletcher32"}; }
+
+        /*! Scale-offset. Lossy for floating point types (H5Z_SO_FLOAT_DSCALE keeps factor decimal digits), lossless for integer types (H5Z_SO_INT) */
+        inline Filter scaleOffset(H5Z_SO_scale_type_t scaleType, int factor) {
+            return Filter{H5Z_FILTER_SCALEOFFSET, {(unsigned int) scaleType, (unsigned int) factor}, H5Z_FLAG_OPTIONAL, "scaleoffset"};
+        }
+
+        /*! N-bit. Packs datatypes with a precision smaller than their size, e.g. 12-bit integers stored in 16 bits */
+        inline Filter nbit() { return Filter{H5Z_FILTER_NBIT, {}, H5Z_FLAG_OPTIONAL, "nbit"}; }
+
+        /*! Zstandard compression (plugin) with level 1 (fast) to 22 (max) */
+        inline Filter zstd(unsigned int level = 3) { return Filter{H5Z_FILTER_ZSTD, {level}, H5Z_FLAG_OPTIONAL, "zstd"}; }
+
+        /*! LZ4 compression (plugin). A block size of 0 selects the default of the plugin */
+        inline Filter lz4(unsigned int blockSize = 0) { return Filter{H5Z_FILTER_LZ4, {blockSize}, H5Z_FLAG_OPTIONAL, "lz4"}; }
+
+        /*! Blosc meta-compressor (plugin). The first four values are reserved and filled in by the plugin.
+         *  Shuffle: 0 none, 1 byte, 2 bit. Compressor: 0 blosclz, 1 lz4, 2 lz4hc, 3 snappy, 4 zlib, 5 zstd */
+        inline Filter blosc(unsigned int level = 5, unsigned int shuffle = 1, unsigned int compressor = 0) {
+            return Filter{H5Z_FILTER_BLOSC, {0, 0, 0, 0, std::min(level, 9u), shuffle, compressor}, H5Z_FLAG_OPTIONAL, "blosc"};
+        }
+    }
+}
@@ -1,13 +1,20 @@
 #pragma once
+#include "h5ppChunks.h"
 #include "h5ppDatasetProperties.h"
 #include "h5ppEigen.h"
 #include "h5ppFilesystem.h"
 #include "h5ppLogger.h"
 #include "h5ppPermissions.h"
 #include "h5ppPropertyLists.h"
+#include "h5ppStats.h"
 #include "h5ppTypeSfinae.h"
 #include "h5ppUtils.h"
+#include <algorithm>
+#include <array>
 #include <hdf5.h>
+#include <hdf5_hl.h>
+#include <map>
+#include <typeindex>
 
 namespace h5pp::hdf5 {
 
@@ -56,11 +63,16 @@ namespace h5pp::hdf5 {
 
     inline bool checkIfLinkExists(const hid::h5f &file, std::string_view linkName, std::optional<bool> linkExists = std::nullopt, const PropertyLists &plists = PropertyLists()) {
         if(linkExists) return linkExists.value();
-        h5pp::logger::log->trace("Checking if link exists: [{}]", linkName);
+        H5PP_TRACE("Checking if link exists: [{}]", linkName);
+        // Each prefix is checked by terminating a single copy of the path after it, instead of copying every prefix into a new string
+        std::string path(linkName);
         for(const auto &subPath : pathCumulativeSplit(linkName, "/")) {
-            int exists = H5Lexists(file, std::string(subPath).c_str(), plists.link_access);
+            const char next      = path[subPath.size()];
+            path[subPath.size()] = '\0';
+            int exists           = H5Lexists(file, path.c_str(), plists.link_access);
+            path[subPath.size()] = next;
             if(exists == 0) {
-                h5pp::logger::log->trace("Checking if link exists: [{}] ... {}", linkName, false);
+                H5PP_TRACE("Checking if link exists: [{}] ... {}", linkName, false);
                 return false;
             }
             if(exists < 0) {
@@ -68,32 +80,25 @@ namespace h5pp::hdf5 {
                 throw std::runtime_error("Failed to check if link exists: [" + std::string(linkName) + "]");
             }
         }
-        h5pp::logger::log->trace("Checking if link exists: [{}] ... {}", linkName, true);
+        H5PP_TRACE("Checking if link exists: [{}] ... {}", linkName, true);
         return true;
     }
 
     inline bool
         checkIfDatasetExists(const hid::h5f &file, std::string_view dsetName, std::optional<bool> dsetExists = std::nullopt, const PropertyLists &plists = PropertyLists()) {
         if(dsetExists) return dsetExists.value();
-        h5pp::logger::log->trace("Checking if dataset exists: [{}]", dsetName);
-        for(const auto &subPath : pathCumulativeSplit(dsetName, "/")) {
-            int exists = H5Lexists(file, std::string(subPath).c_str(), plists.link_access);
-            if(exists == 0) {
-                h5pp::logger::log->trace("Checking if dataset exists: [{}] ... false", dsetName);
-                return false;
-            }
-            if(exists < 0) {
-                H5Eprint(H5E_DEFAULT, stderr);
-                throw std::runtime_error("Failed to check if dataset exists: [" + std::string(dsetName) + "]");
-            }
+        H5PP_TRACE("Checking if dataset exists: [{}]", dsetName);
+        if(not checkIfLinkExists(file, dsetName, std::nullopt, plists)) {
+            H5PP_TRACE("Checking if dataset exists: [{}] ... false", dsetName);
+            return false;
         }
         hid::h5o   object     = H5Oopen(file, std::string(dsetName).c_str(), plists.link_access);
         H5I_type_t objectType = H5Iget_type(object);
         if(objectType != H5I_DATASET) {
-            h5pp::logger::log->trace("Checking if dataset exists: [{}] ... false", dsetName);
+            H5PP_TRACE("Checking if dataset exists: [{}] ... false", dsetName);
             return false;
         } else {
-            h5pp::logger::log->trace("Checking if dataset exists: [{}] ... true", dsetName);
+            H5PP_TRACE("Checking if dataset exists: [{}] ... true", dsetName);
             return true;
         }
     }
@@ -101,7 +106,7 @@ namespace h5pp::hdf5 {
     [[nodiscard]] inline hid::h5o
         openLink(const hid::h5f &file, std::string_view linkName, std::optional<bool> linkExists = std::nullopt, const PropertyLists &plists = PropertyLists()) {
         if(checkIfLinkExists(file, linkName, linkExists, plists)) {
-            h5pp::logger::log->trace("Opening link: [{}]", linkName);
+            H5PP_TRACE("Opening link: [{}]", linkName);
             hid::h5o linkObject = H5Oopen(file, std::string(linkName).c_str(), plists.link_access);
             if(linkObject < 0) {
                 H5Eprint(H5E_DEFAULT, stderr);
@@ -117,7 +122,7 @@ namespace h5pp::hdf5 {
     template<typename h5x>
     [[nodiscard]] h5x openObject(const hid::h5f &file, std::string_view objectName, std::optional<bool> objectExists = std::nullopt, const hid::h5p &object_access = H5P_DEFAULT) {
         if(checkIfLinkExists(file, objectName, objectExists)) {
-            h5pp::logger::log->trace("Opening object: [{}]", objectName);
+            H5PP_TRACE("Opening object: [{}]", objectName);
             h5x object;
             if constexpr(std::is_same_v<h5x, hid::h5d>) object = H5Dopen(file, std::string(objectName).c_str(), object_access);
             if constexpr(std::is_same_v<h5x, hid::h5g>) object = H5Gopen(file, std::string(objectName).c_str(), object_access);
@@ -137,7 +142,7 @@ namespace h5pp::hdf5 {
     [[nodiscard]] inline bool checkEqualTypesRecursive(const hid::h5t &type1, const hid::h5t &type2) {
         // If types are compound, check recursively that all members have equal types and names
         H5T_class_t dataClass1 = H5Tget_class(type1);
-        H5T_class_t dataClass2 = H5Tget_class(type1);
+        H5T_class_t dataClass2 = H5Tget_class(type2);
         if(dataClass1 == H5T_COMPOUND and dataClass2 == H5T_COMPOUND) {
             int num_members1 = H5Tget_nmembers(type1);
             int num_members2 = H5Tget_nmembers(type2);
@@ -166,39 +171,88 @@ namespace h5pp::hdf5 {
         }
     }
 
-    [[nodiscard]] inline bool checkIfCompressionIsAvailable() {
+    inline std::map<std::pair<std::type_index, std::string>, bool> typeMatchCache; /*!< Memoized results of checkIfTypesMatch */
+
+    template<typename DataType>
+    [[nodiscard]] bool checkIfTypesMatch(const hid::h5t &fileType, const std::optional<bool> typesMatch = std::nullopt) {
         /*
-         * Check if zlib compression is available and can be used for both
-         * compression and decompression. We do not throw errors because this
-         * filter is an optional part of the hdf5 library.
+         * Checks that the type of an existing dataset or attribute matches DataType, like checkEqualTypesRecursive.
+         * Comparing compound types walks every member, so the result is remembered, keyed by the C++ type and
+         * the serialized type on file, and repeated overwrites with the same C++ type pay for it only once per process.
+         * Other types are compared directly, which costs no more than serializing them.
+         * If typesMatch is given, it is trusted and returned without any check.
          */
-        htri_t zlib_avail = H5Zfilter_avail(H5Z_FILTER_DEFLATE);
-        if(zlib_avail) {
-            unsigned int filter_info;
-            H5Zget_filter_info(H5Z_FILTER_DEFLATE, &filter_info);
-            bool zlib_encode = (filter_info & H5Z_FILTER_CONFIG_ENCODE_ENABLED);
-            bool zlib_decode = (filter_info & H5Z_FILTER_CONFIG_DECODE_ENABLED);
-            return zlib_avail and zlib_encode and zlib_decode;
+        if(typesMatch) return typesMatch.value();
+        h5pp::stats::Timer timer(&h5pp::IoStats::typeChecks);
+        if(H5Tget_class(fileType) != H5T_COMPOUND) return checkEqualTypesRecursive(fileType, h5pp::utils::getH5Type<DataType>());
+        size_t signatureSize = 0;
+        if(H5Tencode(fileType, nullptr, &signatureSize) < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to get the size of an encoded type");
+        }
+        std::string signature(signatureSize, '\0');
+        if(H5Tencode(fileType, signature.data(), &signatureSize) < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to encode type");
+        }
+        auto key    = std::make_pair(std::type_index(typeid(DataType)), std::move(signature));
+        auto cached = typeMatchCache.find(key);
+        if(cached != typeMatchCache.end()) return cached->second;
+        bool match = checkEqualTypesRecursive(fileType, h5pp::utils::getH5Type<DataType>());
+        H5PP_TRACE("Caching type comparison for [{}]: {}", typeid(DataType).name(), match);
+        typeMatchCache.emplace(std::move(key), match);
+        return match;
+    }
+
+    [[nodiscard]] inline bool checkIfFilterIsAvailable(H5Z_filter_t filterId) {
+        /*
+         * Check if a filter is available and can be used for both
+         * compression and decompression. We do not throw errors because
+         * filters are optional parts of the hdf5 library, or plugins.
+         * Note that H5Zfilter_avail tries to load plugins from HDF5_PLUGIN_PATH.
+         */
+        htri_t filter_avail = H5Zfilter_avail(filterId);
+        if(filter_avail > 0) {
+            unsigned int filter_info = 0;
+            if(H5Zget_filter_info(filterId, &filter_info) < 0) return false;
+            bool filter_encode = (filter_info & H5Z_FILTER_CONFIG_ENCODE_ENABLED);
+            bool filter_decode = (filter_info & H5Z_FILTER_CONFIG_DECODE_ENABLED);
+            return filter_encode and filter_decode;
         } else {
+            H5Eclear(H5E_DEFAULT);
             return false;
         }
     }
 
+    [[nodiscard]] inline bool checkIfCompressionIsAvailable() {
+        // Check if zlib compression is available
+        return checkIfFilterIsAvailable(H5Z_FILTER_DEFLATE);
+    }
+
+    [[nodiscard]] inline size_t getChunkCacheBytes(const PropertyLists &plists) {
+        // The size of the chunk cache that datasets will get, from the dataset access or file access property lists
+        size_t nbytes = 0;
+        if(plists.dset_access != H5P_DEFAULT and H5Pget_chunk_cache(plists.dset_access, nullptr, &nbytes, nullptr) >= 0 and nbytes != H5D_CHUNK_CACHE_NBYTES_DEFAULT)
+            return nbytes;
+        if(plists.file_access != H5P_DEFAULT and H5Pget_cache(plists.file_access, nullptr, nullptr, &nbytes, nullptr) >= 0) return nbytes;
+        return ChunkCache().nbytes;
+    }
+
     [[nodiscard]] inline unsigned int getValidCompressionLevel(std::optional<unsigned int> desiredCompressionLevel = std::nullopt) {
         if(checkIfCompressionIsAvailable()) {
             if(desiredCompressionLevel.has_value()) {
                 if(desiredCompressionLevel.value() < 10) {
-                    h5pp::logger::log->trace("Given valid compression level {}", desiredCompressionLevel.value());
+                    H5PP_TRACE("Given valid compression level {}", desiredCompressionLevel.value());
                     return desiredCompressionLevel.value();
                 } else {
-                    h5pp::logger::log->debug("Given compression level: {} is too high. Expected value 0 (min) to 9 (max). Returning 9");
+                    H5PP_DEBUG("Given compression level: {} is too high. Expected value 0 (min) to 9 (max). Returning 9");
                     return 9;
                 }
             } else {
                 return 0;
             }
         } else {
-            h5pp::logger::log->debug("Compression is not available with this HDF5 library");
+            H5PP_DEBUG("Compression is not available with this HDF5 library");
             return 0;
         }
     }
@@ -230,7 +284,7 @@ namespace h5pp::hdf5 {
                                                      const PropertyLists &plists     = PropertyLists()) {
         if(linkExists and attrExists and linkExists.value() and attrExists.value()) return true;
         hid::h5o link = openLink(file, linkName, linkExists, plists);
-        h5pp::logger::log->trace("Checking if attribute [{}] exitst in link [{}]", attrName, linkName);
+        H5PP_TRACE("Checking if attribute [{}] exitst in link [{}]", attrName, linkName);
         bool         exists    = false;
         unsigned int num_attrs = H5Aget_num_attrs(link);
 
@@ -248,7 +302,7 @@ namespace h5pp::hdf5 {
                 break;
             }
         }
-        h5pp::logger::log->trace("Checking if attribute [{}] exitst in link [{}] ... {}", attrName, linkName, exists);
+        H5PP_TRACE("Checking if attribute [{}] exitst in link [{}] ... {}", attrName, linkName, exists);
         return exists;
     }
 
@@ -259,7 +313,7 @@ namespace h5pp::hdf5 {
                               std::optional<bool>  linkExists = std::nullopt,
                               const PropertyLists &plists     = PropertyLists()) {
         hid::h5o dataset = openLink(file, datasetRelativeName, linkExists, plists);
-        h5pp::logger::log->trace("Extending dataset [ {} ] dimension [{}] to extent [{}]", datasetRelativeName, dim, extent);
+        H5PP_TRACE("Extending dataset [ {} ] dimension [{}] to extent [{}]", datasetRelativeName, dim, extent);
         // Retrieve the current size of the memSpace (act as if you don't know its size and want to append)
         hid::h5a             dataSpace = H5Dget_space(dataset);
         const int            ndims     = H5Sget_simple_extent_ndims(dataSpace);
@@ -294,17 +348,17 @@ namespace h5pp::hdf5 {
         // Check if group exists already
         linkExists = checkIfLinkExists(file, groupRelativeName, linkExists, plists);
         if(linkExists.value()) {
-            h5pp::logger::log->trace("Group already exists: {}", groupRelativeName);
+            H5PP_TRACE("Group already exists: {}", groupRelativeName);
             return;
         } else {
-            h5pp::logger::log->trace("Creating group link: {}", groupRelativeName);
+            H5PP_TRACE("Creating group link: {}", groupRelativeName);
             hid::h5g group = H5Gcreate(file, std::string(groupRelativeName).c_str(), plists.link_create, plists.group_create, plists.group_access);
         }
     }
 
     inline void writeSymbolicLink(hid::h5f &file, std::string_view src_path, std::string_view tgt_path, const PropertyLists &plists = PropertyLists()) {
         if(checkIfLinkExists(file, src_path, std::nullopt, plists)) {
-            h5pp::logger::log->trace("Creating symbolik link: [{}] --> [{}]", src_path, tgt_path);
+            H5PP_TRACE("Creating symbolik link: [{}] --> [{}]", src_path, tgt_path);
             herr_t retval = H5Lcreate_soft(std::string(src_path).c_str(), file, std::string(tgt_path).c_str(), plists.link_create, plists.link_access);
             if(retval < 0) {
                 H5Eprint(H5E_DEFAULT, stderr);
@@ -317,14 +371,14 @@ namespace h5pp::hdf5 {
     }
 
     inline void setDatasetCreationPropertyLayout(const DatasetProperties &dsetProps) {
-        h5pp::logger::log->trace("Setting layout in dataset creation property list");
+        H5PP_TRACE("Setting layout in dataset creation property list");
         herr_t err = H5Pset_layout(dsetProps.plist_dset_create, dsetProps.layout.value());
         if(err < 0) {
             H5Eprint(H5E_DEFAULT, stderr);
             throw std::runtime_error("Could not set layout");
         }
         if(dsetProps.layout.value() == H5D_CHUNKED) {
-            h5pp::logger::log->trace("Setting chunk dimensions in dataset creation property list");
+            H5PP_TRACE("Setting chunk dimensions in dataset creation property list");
             err = H5Pset_chunk(dsetProps.plist_dset_create, dsetProps.ndims.value(), dsetProps.chunkDims.value().data());
             if(err < 0) {
                 H5Eprint(H5E_DEFAULT, stderr);
@@ -334,40 +388,101 @@ namespace h5pp::hdf5 {
     }
 
     inline void setDatasetCreationPropertyCompression(const DatasetProperties &dsetProps) {
-        h5pp::logger::log->trace("Setting compression in dataset creation property list");
+        H5PP_TRACE("Setting compression in dataset creation property list");
         // We assume that compression level is nonzero only if compression is actually available.
         // We do not check it here, but H5Pset_deflate will return an error if zlib is not enabled.
-        if(dsetProps.compressionLevel and dsetProps.compressionLevel.value() == 0 and dsetProps.compressionLevel.value() < 10) {
-            if(dsetProps.layout.value() == H5D_CHUNKED) {
+        if(dsetProps.compressionLevel and dsetProps.compressionLevel.value() > 0 and dsetProps.compressionLevel.value() < 10) {
+            bool hasDeflate = dsetProps.filters and std::any_of(dsetProps.filters->begin(), dsetProps.filters->end(), [](const Filter &f) { return f.id == H5Z_FILTER_DEFLATE; });
+            if(hasDeflate) {
+                H5PP_TRACE("Compression level ignored: The given filters include deflate");
+            } else if(dsetProps.layout.value() == H5D_CHUNKED) {
                 herr_t err = H5Pset_deflate(dsetProps.plist_dset_create, dsetProps.compressionLevel.value());
                 if(err < 0) {
                     H5Eprint(H5E_DEFAULT, stderr);
                     h5pp::logger::log->error("Failed to set compression level. Check that your HDF5 version has zlib enabled.");
                     throw std::runtime_error("Failed to set compression level. Check that your HDF5 version has zlib enabled.");
                 } else {
-                    h5pp::logger::log->trace("Compression set to level {}", dsetProps.compressionLevel.value());
+                    H5PP_TRACE("Compression set to level {}", dsetProps.compressionLevel.value());
                 }
             } else {
-                h5pp::logger::log->trace("Compression ignored: Layout is not H5D_CHUNKED");
+                H5PP_TRACE("Compression ignored: Layout is not H5D_CHUNKED");
+            }
+        } else if(dsetProps.compressionLevel and dsetProps.compressionLevel.value() >= 10) {
+            h5pp::logger::log->warn("Invalid compression level {}", dsetProps.compressionLevel.value());
+        }
+    }
+
+    inline void setDatasetCreationPropertyFilters(const DatasetProperties &dsetProps) {
+        if(not dsetProps.filters or dsetProps.filters->empty()) return;
+        if(dsetProps.layout.value() != H5D_CHUNKED) {
+            H5PP_TRACE("Filters ignored: Layout is not H5D_CHUNKED");
+            return;
+        }
+        H5PP_TRACE("Setting filters in dataset creation property list");
+        for(const auto &filter : dsetProps.filters.value()) {
+            if(not checkIfFilterIsAvailable(filter.id)) {
+                if(filter.flags & H5Z_FLAG_OPTIONAL) {
+                    h5pp::logger::log->warn("Skipping optional filter [{}] with id {}: Not available in this HDF5 library", filter.name, filter.id);
+                    continue;
+                }
+                throw std::runtime_error("Filter [" + filter.name + "] with id " + std::to_string(filter.id) + " is not available in this HDF5 library");
             }
-        } else if(dsetProps.compressionLevel) {
-            h5pp::logger::log->warn("Invalid compression level", dsetProps.compressionLevel.value());
+            herr_t err = H5Pset_filter(dsetProps.plist_dset_create, filter.id, filter.flags, filter.params.size(), filter.params.data());
+            if(err < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to set filter [" + filter.name + "] with id " + std::to_string(filter.id));
+            }
+            H5PP_TRACE("Filter [{}] set with parameters {}", filter.name, filter.params);
         }
     }
 
+    [[nodiscard]] inline std::vector<Filter> getFilters(const hid::h5p &plist_dset_create) {
+        // Reads back the filter pipeline of a dataset, e.g. from H5Dget_create_plist
+        std::vector<Filter> filters;
+        int                 nfilters = H5Pget_nfilters(plist_dset_create);
+        if(nfilters < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to get the number of filters");
+        }
+        for(int idx = 0; idx < nfilters; idx++) {
+            Filter                    filter;
+            std::array<char, 256>     name{};
+            size_t                    nparams = 16;
+            std::vector<unsigned int> params(nparams);
+            filter.id = H5Pget_filter2(plist_dset_create, (unsigned int) idx, &filter.flags, &nparams, params.data(), name.size(), name.data(), nullptr);
+            if(filter.id < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to get filter number " + std::to_string(idx));
+            }
+            if(nparams > params.size()) {
+                // Some filters store more parameters after set_local, e.g. 20 for scale-offset
+                params.resize(nparams);
+                if(H5Pget_filter2(plist_dset_create, (unsigned int) idx, &filter.flags, &nparams, params.data(), name.size(), name.data(), nullptr) < 0) {
+                    H5Eprint(H5E_DEFAULT, stderr);
+                    throw std::runtime_error("Failed to get filter number " + std::to_string(idx));
+                }
+            }
+            params.resize(nparams);
+            filter.params = params;
+            filter.name   = name.data();
+            filters.emplace_back(filter);
+        }
+        return filters;
+    }
+
     inline void setDatasetExtent(const DatasetProperties &dsetProps) {
-        h5pp::logger::log->trace("Setting extent on dataset");
+        H5PP_TRACE("Setting extent on dataset");
         if(not dsetProps.dataSet) throw std::runtime_error("Extent can only be set on a valid dataset id. Got: " + std::to_string(dsetProps.dataSet));
         // Setting extent works only on chunked datasets
         if(dsetProps.layout.value() == H5D_CHUNKED) {
-            h5pp::logger::log->trace("Setting dataset extent: {}", dsetProps.dims.value());
+            H5PP_TRACE("Setting dataset extent: {}", dsetProps.dims.value());
             herr_t err = H5Dset_extent(dsetProps.dataSet, dsetProps.dims.value().data());
             if(err < 0) {
                 H5Eprint(H5E_DEFAULT, stderr);
                 throw std::runtime_error("Could not set extent");
             }
         } else {
-            h5pp::logger::log->trace("Extent ignored: Layout not H5D_CHUNKED");
+            H5PP_TRACE("Extent ignored: Layout not H5D_CHUNKED");
         }
     }
 
@@ -375,7 +490,7 @@ namespace h5pp::hdf5 {
         if(not dsetProps.dataSpace) throw std::runtime_error("Extent can only be set on a valid dataspace id");
         // Setting extent works only on chunked layouts
         if(dsetProps.layout.value() == H5D_CHUNKED) {
-            h5pp::logger::log->trace("Setting dataspace extents: {}", dsetProps.dims.value());
+            H5PP_TRACE("Setting dataspace extents: {}", dsetProps.dims.value());
             std::vector<hsize_t> maxDims(dsetProps.ndims.value());
             std::fill_n(maxDims.begin(), dsetProps.ndims.value(), H5S_UNLIMITED);
             herr_t err = H5Sset_extent_simple(dsetProps.dataSpace, dsetProps.ndims.value(), dsetProps.dims.value().data(), maxDims.data());
@@ -385,7 +500,7 @@ namespace h5pp::hdf5 {
                 throw std::runtime_error("Could not set extent on dataspace");
             }
         } else {
-            h5pp::logger::log->trace("Layout not H5D_CHUNKED: skip setting extent on dataspace");
+            H5PP_TRACE("Layout not H5D_CHUNKED: skip setting extent on dataspace");
         }
     }
 
@@ -393,7 +508,8 @@ namespace h5pp::hdf5 {
         // Here we create, or register, the dataset id and set its properties before writing data to it.
         if(dsetProps.dsetExists and dsetProps.dsetExists.value()) return;
         if(dsetProps.dataSet) return;
-        h5pp::logger::log->trace("Creating dataset: [{}]", dsetProps.dsetName.value());
+        H5PP_TRACE("Creating dataset: [{}]", dsetProps.dsetName.value());
+        h5pp::stats::Timer timer(&h5pp::IoStats::datasetCreates);
         dsetProps.dataSet = H5Dcreate(
             file, dsetProps.dsetName.value().c_str(), dsetProps.dataType, dsetProps.dataSpace, plists.link_create, dsetProps.plist_dset_create, dsetProps.plist_dset_access);
     }
@@ -402,7 +518,7 @@ namespace h5pp::hdf5 {
         // Here we create, or register, the attribute id and set its properties before writing data to it.
         if(attrProps.attrExists and attrProps.attrExists.value()) return;
         if(attrProps.attributeId) return;
-        h5pp::logger::log->trace("Creating attribute: [{}]", attrProps.attrName.value());
+        H5PP_TRACE("Creating attribute: [{}]", attrProps.attrName.value());
         attrProps.attributeId =
             H5Acreate(attrProps.linkObject, attrProps.attrName.value().c_str(), attrProps.dataType, attrProps.memSpace, attrProps.plist_attr_create, attrProps.plist_attr_access);
     }
@@ -418,6 +534,41 @@ namespace h5pp::hdf5 {
         H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start.data(), nullptr, memDims.data(), nullptr);
     }
 
+    inline void selectHyperslab(const hid::h5s &                           space,
+                                const std::vector<hsize_t> &               offset,
+                                const std::vector<hsize_t> &               extent,
+                                const std::optional<std::vector<hsize_t>> &stride = std::nullopt) {
+        const int ndims = H5Sget_simple_extent_ndims(space);
+        if(offset.size() != (size_t) ndims or extent.size() != (size_t) ndims or (stride and stride->size() != (size_t) ndims))
+            throw std::runtime_error("Hyperslab rank mismatch: dataspace has rank " + std::to_string(ndims) + " | offset rank " + std::to_string(offset.size()) +
+                                     " | extent rank " + std::to_string(extent.size()));
+        herr_t err = H5Sselect_hyperslab(space, H5S_SELECT_SET, offset.data(), stride ? stride->data() : nullptr, extent.data(), nullptr);
+        if(err < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to select hyperslab");
+        }
+    }
+
+    inline void checkHyperslabBounds(const std::vector<hsize_t> &               dims,
+                                     const std::vector<hsize_t> &               offset,
+                                     const std::vector<hsize_t> &               extent,
+                                     const std::optional<std::vector<hsize_t>> &stride,
+                                     std::string_view                           dsetName) {
+        // The last element selected in dimension i is offset[i] + (extent[i]-1) * stride[i], which has to fit in dims[i]
+        if(offset.size() != dims.size() or extent.size() != dims.size() or (stride and stride->size() != dims.size()))
+            throw std::runtime_error("Hyperslab rank mismatch on dataset [" + std::string(dsetName) + "]: dataset has rank " + std::to_string(dims.size()) +
+                                     " | offset rank " + std::to_string(offset.size()) + " | extent rank " + std::to_string(extent.size()));
+        for(size_t idx = 0; idx < dims.size(); idx++) {
+            hsize_t step = stride ? stride->at(idx) : 1;
+            if(step == 0) throw std::runtime_error("Hyperslab stride must be positive on dataset [" + std::string(dsetName) + "]");
+            if(extent[idx] == 0) continue;
+            hsize_t last = offset[idx] + (extent[idx] - 1) * step;
+            if(last >= dims[idx])
+                throw std::runtime_error("Hyperslab out of bounds on dataset [" + std::string(dsetName) + "]: Dimension " + std::to_string(idx) + " has size [" +
+                                         std::to_string(dims[idx]) + "], but the selection reaches index [" + std::to_string(last) + "]");
+        }
+    }
+
     inline herr_t fileInfo([[maybe_unused]] hid_t loc_id, const char *name, [[maybe_unused]] const H5L_info_t *linfo, void *opdata) {
         try {
             auto linkNames = reinterpret_cast<std::vector<std::string> *>(opdata);
@@ -427,7 +578,7 @@ namespace h5pp::hdf5 {
     }
 
     inline std::vector<std::string> getContentsOfGroup(hid::h5f &file, std::string_view groupName) {
-        h5pp::logger::log->trace("Getting contents of group: {}", groupName);
+        H5PP_TRACE("Getting contents of group: {}", groupName);
         std::vector<std::string> linkNames;
         try {
             herr_t err = H5Literate_by_name(file, std::string(groupName).c_str(), H5_INDEX_NAME, H5_ITER_NATIVE, nullptr, fileInfo, &linkNames, H5P_DEFAULT);
@@ -435,35 +586,264 @@ namespace h5pp::hdf5 {
                 H5Eprint(H5E_DEFAULT, stderr);
                 throw std::runtime_error("Failed to iterate group: " + std::string(groupName));
             }
-        } catch(std::exception &ex) { h5pp::logger::log->debug("Failed to get contents: {}", ex.what()); }
+        } catch(std::exception &ex) { H5PP_DEBUG("Failed to get contents: {}", ex.what()); }
         return linkNames;
     }
 
+    [[nodiscard]] inline bool getSelectionOffset(const hid::h5s &space, std::vector<hsize_t> &offset) {
+        // Gets the offset of a selection consisting of a single contiguous block, such as H5S_ALL or a hyperslab without stride.
+        // Returns false for any other selection.
+        if(not space.valid()) return false;
+        const int ndims = H5Sget_simple_extent_ndims(space);
+        if(ndims < 0) return false;
+        offset.assign((size_t) ndims, 0);
+        H5S_sel_type selType = H5Sget_select_type(space);
+        if(selType == H5S_SEL_ALL) return true;
+        if(selType != H5S_SEL_HYPERSLABS or H5Sis_regular_hyperslab(space) <= 0) return false;
+        std::vector<hsize_t> stride(offset.size()), count(offset.size()), block(offset.size());
+        if(H5Sget_regular_hyperslab(space, offset.data(), stride.data(), count.data(), block.data()) < 0) return false;
+        for(size_t idx = 0; idx < offset.size(); idx++)
+            if(count[idx] > 1 and stride[idx] != block[idx]) return false;
+        return true;
+    }
+
+#ifdef H5PP_EIGEN3
+    template<typename DataType>
+    [[nodiscard]] bool writeDatasetTiled(const DataType &data, const DatasetProperties &props, const PropertyLists &plists = PropertyLists()) {
+        // Writes column-major Eigen data to the row-major file in tiles of bounded size, transposing one tile at a time,
+        // so that large column-major objects never need a full row-major temporary.
+        // Returns false if the file space selection is not a single block, in which case the caller should fall back to a full transpose.
+        std::vector<hsize_t> offset;
+        if(not getSelectionOffset(props.fileSpace, offset)) return false;
+        using Scalar                    = typename DataType::Scalar;
+        const auto           dims       = h5pp::utils::getDimensions(data);
+        const auto           tileElems  = std::max<size_t>(1, h5pp::constants::maxSizeTransposeTile / sizeof(Scalar));
+        std::vector<hsize_t> tileOffset = offset;
+        std::vector<hsize_t> tileExtent = dims;
+        auto                 writeTile  = [&](const Scalar *tileData) {
+            hid::h5s fileSpace = H5Dget_space(props.dataSet);
+            hid::h5s memSpace  = H5Screate_simple((int) tileExtent.size(), tileExtent.data(), nullptr);
+            selectHyperslab(fileSpace, tileOffset, tileExtent);
+            h5pp::stats::Timer timer(&h5pp::IoStats::datasetWrites, std::accumulate(tileExtent.begin(), tileExtent.end(), sizeof(Scalar), std::multiplies<>()));
+            if(H5Dwrite(props.dataSet, props.dataType, memSpace, fileSpace, plists.dset_xfer, tileData) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to write tile to dataset [" + props.dsetName.value() + "]");
+            }
+        };
+        H5PP_DEBUG("Writing column-major data to dataset [{}] in tiles of at most {} elements", props.dsetName.value(), tileElems);
+        if constexpr(h5pp::type::sfinae::is_eigen_dense<DataType>::value) {
+            // Tiles of whole rows if they fit, otherwise of row segments, so that each tile is a contiguous range of the row-major file
+            using Index          = Eigen::Index;
+            const Index rows     = data.rows();
+            const Index cols     = data.cols();
+            const Index tileCols = std::max<Index>(1, std::min<Index>(cols, (Index) tileElems));
+            const Index tileRows = std::max<Index>(1, std::min<Index>(rows, (Index) tileElems / tileCols));
+            Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> tile;
+            for(Index row = 0; row < rows; row += tileRows) {
+                for(Index col = 0; col < cols; col += tileCols) {
+                    const Index numRows = std::min(tileRows, rows - row);
+                    const Index numCols = std::min(tileCols, cols - col);
+                    h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
+                    tile = data.block(row, col, numRows, numCols).matrix();
+                    conversion.stop();
+                    tileOffset          = {offset[0] + (hsize_t) row, offset[1] + (hsize_t) col};
+                    tileExtent          = {(hsize_t) numRows, (hsize_t) numCols};
+                    writeTile(tile.data());
+                }
+            }
+        } else if constexpr(h5pp::type::sfinae::is_eigen_tensor<DataType>::value) {
+            // Slabs along the last index, which is the slowest in column-major storage. A slab is at least one slice thick.
+            constexpr auto rank      = DataType::NumIndices;
+            const auto     sliceSize = std::accumulate(dims.begin(), dims.end() - 1, (hsize_t) 1, std::multiplies<>());
+            const auto     slabSize  = std::max<hsize_t>(1, tileElems / std::max<hsize_t>(1, sliceSize));
+            eigen::array<rank> sliceOffsets{};
+            eigen::array<rank> sliceExtents{};
+            eigen::array<rank> reverse{};
+            std::copy(dims.begin(), dims.end(), sliceExtents.begin());
+            std::iota(reverse.begin(), reverse.end(), 0);
+            std::reverse(reverse.begin(), reverse.end());
+            Eigen::Tensor<Scalar, rank, Eigen::RowMajor> tile;
+            for(hsize_t slab = 0; slab < dims.back(); slab += slabSize) {
+                sliceOffsets.back() = (eigen::idxType) slab;
+                sliceExtents.back() = (eigen::idxType) std::min(slabSize, dims.back() - slab);
+                h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
+                tile = data.slice(sliceOffsets, sliceExtents).swap_layout().shuffle(reverse);
+                conversion.stop();
+                tileOffset.back()   = offset.back() + slab;
+                tileExtent.back()   = (hsize_t) sliceExtents.back();
+                writeTile(tile.data());
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    template<typename DataType>
+    [[nodiscard]] bool readDatasetTiled(DataType &data, const DatasetProperties &props, const PropertyLists &plists = PropertyLists()) {
+        // Reads row-major data from file into a column-major Eigen container in tiles of bounded size, transposing one tile at a time,
+        // so that large column-major objects never need a full row-major temporary.
+        // Tiles are hyperslabs, so they are decompressed by HDF5 on the calling thread, not by readDatasetParallel.
+        // Returns false if the file space selection is not a single block, in which case the caller should fall back to a full transpose.
+        std::vector<hsize_t> offset;
+        if(not getSelectionOffset(props.dataSpace, offset)) return false;
+        using Scalar                    = typename DataType::Scalar;
+        const auto           dims       = props.dims.value();
+        const auto           tileElems  = std::max<size_t>(1, h5pp::constants::maxSizeTransposeTile / sizeof(Scalar));
+        std::vector<hsize_t> tileOffset = offset;
+        std::vector<hsize_t> tileExtent = dims;
+        auto                 readTile   = [&](Scalar *tileData) {
+            hid::h5s fileSpace = H5Dget_space(props.dataSet);
+            hid::h5s memSpace  = H5Screate_simple((int) tileExtent.size(), tileExtent.data(), nullptr);
+            selectHyperslab(fileSpace, tileOffset, tileExtent);
+            h5pp::stats::Timer timer(&h5pp::IoStats::datasetReads, std::accumulate(tileExtent.begin(), tileExtent.end(), sizeof(Scalar), std::multiplies<>()));
+            if(H5Dread(props.dataSet, props.dataType, memSpace, fileSpace, plists.dset_xfer, tileData) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to read tile from dataset [" + props.dsetName.value() + "]");
+            }
+        };
+        H5PP_DEBUG("Reading column-major data from dataset [{}] in tiles of at most {} elements", props.dsetName.value(), tileElems);
+        if constexpr(h5pp::type::sfinae::is_eigen_dense<DataType>::value) {
+            // Tiles of whole rows if they fit, otherwise of row segments, so that each tile is a contiguous range of the row-major file
+            using Index = Eigen::Index;
+            data.resize((Index) dims[0], (Index) dims[1]);
+            const Index rows     = data.rows();
+            const Index cols     = data.cols();
+            const Index tileCols = std::max<Index>(1, std::min<Index>(cols, (Index) tileElems));
+            const Index tileRows = std::max<Index>(1, std::min<Index>(rows, (Index) tileElems / tileCols));
+            Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> tile;
+            for(Index row = 0; row < rows; row += tileRows) {
+                for(Index col = 0; col < cols; col += tileCols) {
+                    const Index numRows = std::min(tileRows, rows - row);
+                    const Index numCols = std::min(tileCols, cols - col);
+                    tile.resize(numRows, numCols);
+                    tileOffset = {offset[0] + (hsize_t) row, offset[1] + (hsize_t) col};
+                    tileExtent = {(hsize_t) numRows, (hsize_t) numCols};
+                    readTile(tile.data());
+                    h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
+                    data.block(row, col, numRows, numCols).matrix() = tile;
+                }
+            }
+        } else if constexpr(h5pp::type::sfinae::is_eigen_tensor<DataType>::value) {
+            // Slabs along the last index, which is the slowest in column-major storage. A slab is at least one slice thick.
+            constexpr auto rank      = DataType::NumIndices;
+            const auto     sliceSize = std::accumulate(dims.begin(), dims.end() - 1, (hsize_t) 1, std::multiplies<>());
+            const auto     slabSize  = std::max<hsize_t>(1, tileElems / std::max<hsize_t>(1, sliceSize));
+            if constexpr(h5pp::type::sfinae::has_resize<DataType>::value) data.resize(eigen::copy_dims<rank>(dims));
+            else if(data.dimensions() != eigen::copy_dims<rank>(dims)) return false; // Maps can't be resized
+            eigen::array<rank> sliceOffsets{};
+            eigen::array<rank> sliceExtents{};
+            eigen::array<rank> reverse{};
+            std::copy(dims.begin(), dims.end(), sliceExtents.begin());
+            std::iota(reverse.begin(), reverse.end(), 0);
+            std::reverse(reverse.begin(), reverse.end());
+            Eigen::Tensor<Scalar, rank, Eigen::RowMajor> tile;
+            for(hsize_t slab = 0; slab < dims.back(); slab += slabSize) {
+                sliceOffsets.back() = (eigen::idxType) slab;
+                sliceExtents.back() = (eigen::idxType) std::min(slabSize, dims.back() - slab);
+                tile.resize(sliceExtents);
+                tileOffset.back() = offset.back() + slab;
+                tileExtent.back() = (hsize_t) sliceExtents.back();
+                readTile(tile.data());
+                h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
+                data.slice(sliceOffsets, sliceExtents) = tile.swap_layout().shuffle(reverse);
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    [[nodiscard]] inline bool writeDatasetParallel([[maybe_unused]] const void *data, [[maybe_unused]] const DatasetProperties &props, [[maybe_unused]] const PropertyLists &plists) {
+        /*
+         * Writes a whole chunked dataset by applying the filters of its chunks on plists.writeThreads worker threads, see
+         * h5pp::chunk::ParallelEncoder, and storing them with H5Dwrite_chunk on this thread. Returns false, having written nothing,
+         * if the dataset can't be written this way: when only part of it is selected, when HDF5 would convert the type, when a
+         * filter can't be applied without HDF5, or when a user-defined fill value would have to pad the chunks on the edges.
+         * H5Dwrite_chunk needs HDF5 1.10.3, so older versions always leave writing to HDF5.
+         */
+#if H5_VERSION_GE(1, 10, 3)
+        if(plists.writeThreads < 2 or props.layout != H5D_CHUNKED or not props.chunkDims or not props.dims) return false;
+        const auto &dims      = props.dims.value();
+        const auto &chunkDims = props.chunkDims.value();
+        hsize_t     size      = 1;
+        hsize_t     numChunks = 1;
+        for(size_t d = 0; d < dims.size(); d++) {
+            size *= dims[d];
+            numChunks *= (dims[d] + chunkDims[d] - 1) / chunkDims[d];
+        }
+        if(numChunks < 2 or chunkDims.size() != dims.size()) return false;
+        // A selection of as many points as the dataset holds selects all of it, whatever its type
+        if(props.fileSpace.valid() and H5Sget_select_npoints(props.fileSpace) != static_cast<hssize_t>(size)) return false;
+        if(props.memSpace.valid() and H5Sget_select_npoints(props.memSpace) != static_cast<hssize_t>(size)) return false;
+        // The dataset may have been resized since the properties were read
+        if(getDimensions(props.dataSet) != dims) return false;
+        hid::h5t fileType = H5Dget_type(props.dataSet);
+        if(H5Tequal(fileType, props.dataType) <= 0 or H5Tis_variable_str(fileType) != 0 or H5Tdetect_class(fileType, H5T_VLEN) != 0 or
+           H5Tdetect_class(fileType, H5T_REFERENCE) != 0)
+            return false;
+        hid::h5p         dsetCreatePlist = H5Dget_create_plist(props.dataSet);
+        H5D_fill_value_t fillValue       = H5D_FILL_VALUE_ERROR;
+        if(H5Pfill_value_defined(dsetCreatePlist, &fillValue) < 0 or fillValue == H5D_FILL_VALUE_USER_DEFINED) return false;
+        auto pipeline = getFilters(dsetCreatePlist);
+        for(const auto &filter : pipeline)
+            if(not h5pp::chunk::canEncode(filter.id)) return false;
+
+        size_t threads = std::min<size_t>(plists.writeThreads, numChunks);
+        H5PP_DEBUG("Writing dataset [{}] in parallel: {} chunks | {} threads", props.dsetName.value(), numChunks, threads);
+        h5pp::chunk::ParallelEncoder encoder(threads, pipeline, dims, chunkDims, H5Tget_size(fileType), data);
+        while(auto chunk = encoder.next()) {
+            if(H5Dwrite_chunk(props.dataSet, plists.dset_xfer, 0, chunk->offset.data(), chunk->data.size(), chunk->data.data()) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to write a chunk of dataset [" + props.dsetName.value() + "]");
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
     template<typename DataType>
     void writeDataset(const DataType &data, const DatasetProperties &props, const PropertyLists &plists = PropertyLists()) {
-        h5pp::logger::log->debug("Writing dataset: [{}] | size {} | bytes {} | ndims {} | dims {} | type {}",
-                                 props.dsetName.value(),
-                                 props.size.value(),
-                                 props.bytes.value(),
-                                 props.ndims.value(),
-                                 props.dims.value(),
-                                 h5pp::type::sfinae::type_name<DataType>());
+        H5PP_DEBUG("Writing dataset: [{}] | size {} | bytes {} | ndims {} | dims {} | type {}",
+                   props.dsetName.value(),
+                   props.size.value(),
+                   props.bytes.value(),
+                   props.ndims.value(),
+                   props.dims.value(),
+                   h5pp::type::sfinae::type_name<DataType>());
         h5pp::utils::assertBytesPerElemMatch<DataType>(props.dataType);
-        if(props.dsetExists.value() and props.layout != H5D_CHUNKED) { h5pp::utils::assertBytesMatchTotal(data, props.dataSet); }
+        if(props.dsetExists.value() and props.layout != H5D_CHUNKED) {
+            // Compare against the selected region only, since we may be writing a hyperslab
+            if(props.fileSpace.valid())
+                h5pp::utils::assertBytesMatchSelection(data, props.fileSpace, H5Dget_type(props.dataSet));
+            else
+                h5pp::utils::assertBytesMatchTotal(data, props.dataSet);
+        }
         herr_t retval = 0;
 
 #ifdef H5PP_EIGEN3
         if constexpr(h5pp::type::sfinae::is_eigen_colmajor<DataType>::value and not h5pp::type::sfinae::is_eigen_1d<DataType>::value) {
-            h5pp::logger::log->debug("Converting data to row-major storage order");
-            const auto tempRowm = eigen::to_RowMajor(data); // Convert to Row Major first;
+            // Large objects are transposed tile by tile, to avoid a full temporary
+            if(h5pp::utils::getBytesTotal(data) > h5pp::constants::maxSizeTransposeTile and writeDatasetTiled(data, props, plists)) return;
+            H5PP_DEBUG("Converting data to row-major storage order");
+            h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
+            const auto         tempRowm = eigen::to_RowMajor(data); // Convert to Row Major first;
+            conversion.stop();
             h5pp::hdf5::writeDataset(tempRowm, props, plists);
         } else
 #endif
             if constexpr(h5pp::type::sfinae::has_data<DataType>::value) {
+            h5pp::stats::Timer timer(&h5pp::IoStats::datasetWrites, h5pp::utils::getBytesSelected(props.memSpace, props.dataType));
+            if(writeDatasetParallel(static_cast<const void *>(data.data()), props, plists)) return;
             retval = H5Dwrite(props.dataSet, props.dataType, props.memSpace, props.fileSpace, plists.dset_xfer, data.data());
         } else if constexpr(std::is_pointer_v<DataType>) {
+            h5pp::stats::Timer timer(&h5pp::IoStats::datasetWrites, h5pp::utils::getBytesSelected(props.memSpace, props.dataType));
             retval = H5Dwrite(props.dataSet, props.dataType, props.memSpace, props.fileSpace, plists.dset_xfer, data);
         } else {
+            h5pp::stats::Timer timer(&h5pp::IoStats::datasetWrites, h5pp::utils::getBytesSelected(props.memSpace, props.dataType));
             retval = H5Dwrite(props.dataSet, props.dataType, props.memSpace, props.fileSpace, plists.dset_xfer, &data);
         }
 
@@ -473,15 +853,148 @@ namespace h5pp::hdf5 {
         }
     }
 
+    template<typename DataType>
+    void writeDataset(const DataType &                           data,
+                      DatasetProperties &                        props,
+                      const std::vector<hsize_t> &               offset,
+                      const std::optional<std::vector<hsize_t>> &stride = std::nullopt,
+                      const PropertyLists &                      plists = PropertyLists()) {
+        // Writes data into the sub-region (hyperslab) of an existing dataset starting at offset. The extent of the region is given by the data.
+        // The properties are expected to describe the dataset on file, with props.dataType set to the type of the data in memory.
+        // Chunked datasets grow to fit the region if their maximum dimensions allow it. Only the chunks overlapping the region are touched.
+        static_assert(not h5pp::type::sfinae::is_text_v<DataType>, "Hyperslab writes are not supported for text types");
+        auto extent  = h5pp::utils::getDimensions(data);
+        auto maxDims = getMaxDimensions(props.dataSet);
+        checkHyperslabBounds(maxDims, offset, extent, stride, props.dsetName.value());
+
+        // Grow the dataset if the region reaches beyond the current extent
+        auto newDims = props.dims.value();
+        for(size_t idx = 0; idx < newDims.size(); idx++) {
+            if(extent[idx] == 0) continue;
+            hsize_t step = stride ? stride->at(idx) : 1;
+            newDims[idx] = std::max(newDims[idx], offset[idx] + (extent[idx] - 1) * step + 1);
+        }
+        if(newDims != props.dims.value()) {
+            if(props.layout.value() != H5D_CHUNKED)
+                throw std::runtime_error("Could not write hyperslab to dataset [" + props.dsetName.value() +
+                                         "]: The region does not fit, and only datasets with layout H5D_CHUNKED can be extended");
+            H5PP_TRACE("Extending dataset [{}] to fit hyperslab: dims {} -> {}", props.dsetName.value(), props.dims.value(), newDims);
+            props.dims = newDims;
+            props.size = std::accumulate(newDims.begin(), newDims.end(), (hsize_t) 1, std::multiplies<>());
+            setDatasetExtent(props);
+        }
+
+        H5PP_TRACE("Selecting hyperslab on dataset [{}]: offset {} | extent {}", props.dsetName.value(), offset, extent);
+        props.fileSpace = H5Dget_space(props.dataSet);
+        selectHyperslab(props.fileSpace, offset, extent, stride);
+        props.memSpace = h5pp::utils::getMemSpace(h5pp::utils::getSize(data), (int) extent.size(), extent);
+        props.bytes    = h5pp::utils::getBytesTotal(data);
+        writeDataset(data, props, plists);
+
+        // Leave the properties describing the whole dataset
+        props.dataSpace = H5Dget_space(props.dataSet);
+        props.fileSpace = H5Dget_space(props.dataSet);
+        props.memSpace  = h5pp::utils::getMemSpace(props.size.value(), props.ndims.value(), props.dims.value());
+        props.bytes     = props.size.value() * H5Tget_size(props.dataType);
+    }
+
+    template<typename DataType>
+    void appendDataset(const DataType &data, DatasetProperties &props, size_t axis = 0, const PropertyLists &plists = PropertyLists()) {
+        // Grows an existing chunked dataset along the given axis and writes the data into the new slab only.
+        // The properties are expected to describe the dataset on file, with props.dataType set to the type of the data in memory.
+        if(props.layout.value() != H5D_CHUNKED)
+            throw std::runtime_error("Could not append to dataset [" + props.dsetName.value() + "]: Only datasets with layout H5D_CHUNKED can be extended");
+        if(axis >= (size_t) props.ndims.value())
+            throw std::runtime_error("Could not append to dataset [" + props.dsetName.value() + "]: Axis " + std::to_string(axis) + " is out of range for rank " +
+                                     std::to_string(props.ndims.value()));
+        auto dataDims = h5pp::utils::getDimensions(data);
+        auto oldDims  = props.dims.value();
+        if(dataDims.size() != oldDims.size())
+            throw std::runtime_error("Could not append to dataset [" + props.dsetName.value() + "]: Data has rank " + std::to_string(dataDims.size()) + " but the dataset has rank " +
+                                     std::to_string(oldDims.size()));
+        for(size_t idx = 0; idx < dataDims.size(); idx++) {
+            if(idx == axis) continue;
+            if(dataDims[idx] != oldDims[idx])
+                throw std::runtime_error("Could not append to dataset [" + props.dsetName.value() + "]: Data dimension " + std::to_string(idx) + " has size [" +
+                                         std::to_string(dataDims[idx]) + "], but the dataset has size [" + std::to_string(oldDims[idx]) + "]");
+        }
+        H5PP_TRACE("Appending to dataset [{}] along axis {}", props.dsetName.value(), axis);
+        std::vector<hsize_t> offset(oldDims.size(), 0);
+        offset[axis] = oldDims[axis];
+        writeDataset(data, props, offset, std::nullopt, plists);
+    }
+
+    [[nodiscard]] inline bool readDatasetParallel([[maybe_unused]] void *data, [[maybe_unused]] const DatasetProperties &props, [[maybe_unused]] const PropertyLists &plists) {
+        /*
+         * Reads a whole chunked dataset by reading its raw chunks with H5Dread_chunk on this thread, and undoing their filters on
+         * plists.readThreads worker threads, see h5pp::chunk::ParallelDecoder. Returns false, having read nothing, if the dataset
+         * can't be read this way: when only part of it is selected, when HDF5 would convert its type, when a filter can't be undone
+         * without HDF5, or when some chunks are unallocated, since HDF5 fills those with the fill value.
+         * The chunks are enumerated from the chunk dimensions, since H5Dget_chunk_info searches from the first chunk on every call.
+         * H5Dget_num_chunks needs HDF5 1.10.5, so older versions always leave reading to HDF5.
+         */
+#if H5_VERSION_GE(1, 10, 5)
+        if(plists.readThreads < 2 or props.layout != H5D_CHUNKED or not props.chunkDims) return false;
+        if(H5Sget_select_type(props.dataSpace) != H5S_SEL_ALL) return false;
+        hid::h5t fileType = H5Dget_type(props.dataSet);
+        if(H5Tequal(fileType, props.dataType) <= 0 or H5Tis_variable_str(fileType) != 0 or H5Tdetect_class(fileType, H5T_VLEN) != 0 or
+           H5Tdetect_class(fileType, H5T_REFERENCE) != 0)
+            return false;
+        auto pipeline = getFilters(props.plist_dset_create);
+        for(const auto &filter : pipeline)
+            if(not h5pp::chunk::canDecode(filter.id)) return false;
+
+        const auto &dims      = props.dims.value();
+        const auto &chunkDims = props.chunkDims.value();
+        hsize_t     numChunks = 1;
+        for(size_t d = 0; d < dims.size(); d++) numChunks *= (dims[d] + chunkDims[d] - 1) / chunkDims[d];
+        hsize_t numAllocated = 0;
+        if(H5Dget_num_chunks(props.dataSet, props.dataSpace, &numAllocated) < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to get the number of chunks in dataset [" + props.dsetName.value() + "]");
+        }
+        if(numChunks < 2 or numAllocated != numChunks) return false;
+
+        size_t threads = std::min<size_t>(plists.readThreads, numChunks);
+        H5PP_DEBUG("Reading dataset [{}] in parallel: {} chunks | {} threads", props.dsetName.value(), numChunks, threads);
+        h5pp::chunk::ParallelDecoder decoder(threads, pipeline, dims, chunkDims, H5Tget_size(fileType), data);
+        std::vector<hsize_t>         offset(dims.size(), 0);
+        for(hsize_t chunk = 0; chunk < numChunks; chunk++) {
+            hsize_t  bytes      = 0;
+            uint32_t filterMask = 0;
+            if(H5Dget_chunk_storage_size(props.dataSet, offset.data(), &bytes) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to get the size of a chunk in dataset [" + props.dsetName.value() + "]");
+            }
+            std::vector<std::byte> raw(bytes);
+            if(H5Dread_chunk(props.dataSet, plists.dset_xfer, offset.data(), &filterMask, raw.data()) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to read a chunk of dataset [" + props.dsetName.value() + "]");
+            }
+            decoder.push(offset, filterMask, std::move(raw));
+            // Next chunk in row-major order
+            for(size_t d = dims.size(); d-- > 0;) {
+                offset[d] += chunkDims[d];
+                if(offset[d] < dims[d]) break;
+                offset[d] = 0;
+            }
+        }
+        decoder.finish();
+        return true;
+#else
+        return false;
+#endif
+    }
+
     template<typename DataType>
     void readDataset(DataType &data, const DatasetProperties &props, const PropertyLists &plists = PropertyLists()) {
-        h5pp::logger::log->debug("Reading dataset: [{}] | size {} | bytes {} | ndims {} | dims {} | type {}",
-                                 props.dsetName.value(),
-                                 props.size.value(),
-                                 props.bytes.value(),
-                                 props.ndims.value(),
-                                 props.dims.value(),
-                                 type::sfinae::type_name<DataType>());
+        H5PP_DEBUG("Reading dataset: [{}] | size {} | bytes {} | ndims {} | dims {} | type {}",
+                   props.dsetName.value(),
+                   props.size.value(),
+                   props.bytes.value(),
+                   props.ndims.value(),
+                   props.dims.value(),
+                   type::sfinae::type_name<DataType>());
         h5pp::utils::assertBytesPerElemMatch<DataType>(props.dataType);
         herr_t retval = 0;
         // Resize/transpose the data container before writing
@@ -495,9 +1008,12 @@ namespace h5pp::hdf5 {
                 data.resize(props.dims.value()[0], props.dims.value()[1]);
             } else if constexpr(h5pp::type::sfinae::is_eigen_colmajor<DataType>::value) {
                 // Data is RowMajor in HDF5, user gave a ColMajor container we need to swap layout.
-                h5pp::logger::log->debug("Transforming data to row major");
-                Eigen::Matrix<typename DataType::Scalar, DataType::RowsAtCompileTime, DataType::RowsAtCompileTime, Eigen::RowMajor> matrixRowmajor;
+                // Large objects are transposed tile by tile, to avoid a full temporary
+                if(props.size.value() * sizeof(typename DataType::Scalar) > h5pp::constants::maxSizeTransposeTile and readDatasetTiled(data, props, plists)) return;
+                H5PP_DEBUG("Transforming data to row major");
+                std::decay_t<decltype(eigen::to_RowMajor(data))> matrixRowmajor;
                 readDataset(matrixRowmajor, props, plists);
+                h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
                 data = matrixRowmajor;
                 return;
             } else {
@@ -510,9 +1026,11 @@ namespace h5pp::hdf5 {
                 data.resize(eigenDims);
             } else {
                 // Data is RowMajor in HDF5, user gave a ColMajor container we need to swap layout.
-                h5pp::logger::log->debug("Transforming data to row major");
+                if(props.size.value() * sizeof(typename DataType::Scalar) > h5pp::constants::maxSizeTransposeTile and readDatasetTiled(data, props, plists)) return;
+                H5PP_DEBUG("Transforming data to row major");
                 Eigen::Tensor<typename DataType::Scalar, DataType::NumIndices, Eigen::RowMajor> tensorRowmajor;
                 readDataset(tensorRowmajor, props, plists);
+                h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
                 data = eigen::to_ColMajor(tensorRowmajor);
                 return;
             }
@@ -528,11 +1046,12 @@ namespace h5pp::hdf5 {
             data.resize(stringsize);
         }
 
-        h5pp::utils::assertBytesMatchTotal(data, props.dataSet);
+        h5pp::utils::assertBytesMatchSelection(data, props.dataSpace, props.dataType);
 
         // Read the data into the container
-
+        h5pp::stats::Timer timer(&h5pp::IoStats::datasetReads, h5pp::utils::getBytesSelected(props.memSpace, props.dataType));
         if constexpr(h5pp::type::sfinae::has_data<DataType>::value) {
+            if(readDatasetParallel(static_cast<void *>(data.data()), props, plists)) return;
             retval = H5Dread(props.dataSet, props.dataType, props.memSpace, props.dataSpace, plists.dset_xfer, data.data());
         } else if constexpr(std::is_arithmetic<DataType>::value) {
             retval = H5Dread(props.dataSet, props.dataType, props.memSpace, props.dataSpace, plists.dset_xfer, &data);
@@ -549,16 +1068,80 @@ namespace h5pp::hdf5 {
         }
     }
 
+    template<typename DataType>
+    void readDataset(DataType &                                 data,
+                     const DatasetProperties &                  props,
+                     const std::vector<hsize_t> &               offset,
+                     const std::vector<hsize_t> &               extent,
+                     const std::optional<std::vector<hsize_t>> &stride = std::nullopt,
+                     const PropertyLists &                      plists = PropertyLists()) {
+        // Reads the sub-region of the dataset given by offset, extent and stride.
+        // The container is resized (if possible) to extent, and only the selected elements are read from file
+        static_assert(not h5pp::type::sfinae::is_text_v<DataType>, "Hyperslab reads are not supported for text types");
+        checkHyperslabBounds(props.dims.value(), offset, extent, stride, props.dsetName.value());
+        H5PP_TRACE("Selecting hyperslab on dataset [{}]: offset {} | extent {}", props.dsetName.value(), offset, extent);
+        DatasetProperties sliceProps = props;
+        sliceProps.dataSpace         = H5Dget_space(props.dataSet); // A fresh copy, so that the selection does not leak into props
+        selectHyperslab(sliceProps.dataSpace, offset, extent, stride);
+        sliceProps.dims     = extent;
+        sliceProps.size     = std::accumulate(extent.begin(), extent.end(), (hsize_t) 1, std::multiplies<>());
+        sliceProps.bytes    = sliceProps.size.value() * H5Tget_size(props.dataType);
+        sliceProps.memSpace = h5pp::utils::getMemSpace(sliceProps.size.value(), props.ndims.value(), extent);
+        readDataset(data, sliceProps, plists);
+    }
+
+#ifdef H5PP_EIGEN3
+    template<typename XprType, int BlockRows, int BlockCols, bool InnerPanel>
+    void readDataset(Eigen::Block<XprType, BlockRows, BlockCols, InnerPanel> block,
+                     const DatasetProperties &                               props,
+                     const std::vector<hsize_t> &                            offset,
+                     const std::optional<std::vector<hsize_t>> &             stride = std::nullopt,
+                     const PropertyLists &                                   plists = PropertyLists()) {
+        // Reads a sub-region of a two-dimensional dataset into a block of an existing matrix. The extent is given by the block.
+        using BlockType = Eigen::Block<XprType, BlockRows, BlockCols, InnerPanel>;
+        using Scalar    = typename BlockType::Scalar;
+        if(props.ndims.value() != 2)
+            throw std::runtime_error("Reading into an Eigen block requires a two-dimensional dataset. Dataset [" + props.dsetName.value() + "] has rank " +
+                                     std::to_string(props.ndims.value()));
+        std::vector<hsize_t> extent = {(hsize_t) block.rows(), (hsize_t) block.cols()};
+        if constexpr(BlockType::IsRowMajor) {
+            if(block.innerStride() == 1) {
+                // Row-major blocks match the layout on file. Describe the block as a hyperslab in memory, and read straight into the parent matrix.
+                h5pp::utils::assertBytesPerElemMatch<Scalar>(props.dataType);
+                checkHyperslabBounds(props.dims.value(), offset, extent, stride, props.dsetName.value());
+                hid::h5s             fileSpace = H5Dget_space(props.dataSet);
+                std::vector<hsize_t> memDims   = {(hsize_t) block.rows(), (hsize_t) block.outerStride()};
+                hid::h5s             memSpace  = H5Screate_simple(2, memDims.data(), nullptr);
+                selectHyperslab(fileSpace, offset, extent, stride);
+                selectHyperslab(memSpace, {0, 0}, extent);
+                H5PP_DEBUG("Reading dataset [{}] into row-major block | offset {} | extent {}", props.dsetName.value(), offset, extent);
+                h5pp::stats::Timer timer(&h5pp::IoStats::datasetReads, static_cast<size_t>(block.size()) * sizeof(Scalar));
+                herr_t             retval = H5Dread(props.dataSet, props.dataType, memSpace, fileSpace, plists.dset_xfer, block.data());
+                if(retval < 0) {
+                    H5Eprint(H5E_DEFAULT, stderr);
+                    throw std::runtime_error("Failed to read dataset [" + props.dsetName.value() + "] into Eigen block");
+                }
+                return;
+            }
+        }
+        // Column-major blocks need a transpose, which HDF5 can't do for us. Go through a row-major buffer the size of the block.
+        Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> blockRowmajor;
+        readDataset(blockRowmajor, props, offset, extent, stride, plists);
+        h5pp::stats::Timer conversion(&h5pp::IoStats::layoutConversions);
+        block = blockRowmajor;
+    }
+#endif
+
     template<typename DataType>
     void writeAttribute(const DataType &data, const AttributeProperties &props) {
-        h5pp::logger::log->debug("Writing attribute: [{}] | link [{}] | size {} | bytes {} | ndims {} | dims {} | type {}",
-                                 props.attrName.value(),
-                                 props.linkName.value(),
-                                 props.size.value(),
-                                 props.bytes.value(),
-                                 props.ndims.value(),
-                                 props.dims.value(),
-                                 type::sfinae::type_name<DataType>());
+        H5PP_DEBUG("Writing attribute: [{}] | link [{}] | size {} | bytes {} | ndims {} | dims {} | type {}",
+                   props.attrName.value(),
+                   props.linkName.value(),
+                   props.size.value(),
+                   props.bytes.value(),
+                   props.ndims.value(),
+                   props.dims.value(),
+                   type::sfinae::type_name<DataType>());
         h5pp::utils::assertBytesPerElemMatch<DataType>(props.dataType);
         if constexpr(h5pp::type::sfinae::has_c_str<DataType>::value) {
             herr_t retval = H5Awrite(props.attributeId, props.dataType, data.c_str());
@@ -588,13 +1171,13 @@ namespace h5pp::hdf5 {
         if(not props.attrExists or not props.attrExists.value())
             throw std::runtime_error("Tried to read non-existing attribute [" + props.attrName.value() + "] on link: [" + props.linkName.value() + "]");
 
-        h5pp::logger::log->debug("Reading attribute: [{}] | link {} | size {} | ndims {} | dims {} | type {}",
-                                 props.attrName.value(),
-                                 props.linkName.value(),
-                                 props.size.value(),
-                                 props.ndims.value(),
-                                 props.dims.value(),
-                                 type::sfinae::type_name<DataType>());
+        H5PP_DEBUG("Reading attribute: [{}] | link {} | size {} | ndims {} | dims {} | type {}",
+                   props.attrName.value(),
+                   props.linkName.value(),
+                   props.size.value(),
+                   props.ndims.value(),
+                   props.dims.value(),
+                   type::sfinae::type_name<DataType>());
         h5pp::utils::assertBytesPerElemMatch<DataType>(props.dataType);
 
 #ifdef H5PP_EIGEN3
@@ -608,7 +1191,7 @@ namespace h5pp::hdf5 {
                 }
             } else {
                 // Data is RowMajor in HDF5, user gave a ColMajor container so we need to swap the layout.
-                h5pp::logger::log->debug("Transforming data to row major");
+                H5PP_DEBUG("Transforming data to row major");
                 Eigen::Matrix<typename DataType::Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> matrixRowmajor;
                 matrixRowmajor.resize(props.dims.value()[0], props.dims.value()[1]); // Data is transposed in HDF5!
                 if(H5Aread(props.attributeId, props.dataType, matrixRowmajor.data()) < 0) {
@@ -629,7 +1212,7 @@ namespace h5pp::hdf5 {
                 }
             } else {
                 // Data is RowMajor in HDF5, user gave a ColMajor container so we need to swap the layout.
-                h5pp::logger::log->debug("Transforming data to row major");
+                H5PP_DEBUG("Transforming data to row major");
                 Eigen::Tensor<typename DataType::Scalar, DataType::NumIndices, Eigen::RowMajor> tensorRowmajor(eigenDims);
                 if(H5Aread(props.attributeId, props.dataType, tensorRowmajor.data()) < 0) {
                     H5Eprint(H5E_DEFAULT, stderr);
@@ -683,6 +1266,60 @@ namespace h5pp::hdf5 {
         return newFileName;
     }
 
+    /*! Create a file with the core driver set in plists, see PropertyLists::setCoreDriver. Without a backing store, the name is only a label.
+     *  OPEN loads an existing file into memory, TRUNCATE overwrites one, and RENAME fails if the file exists, so the caller picks a free name first */
+    [[nodiscard]] inline hid::h5f createMemoryFile(const h5pp::fs::path &fileName, const CreateMode &createMode, const PropertyLists &plists) {
+        hid_t file;
+        switch(createMode) {
+            case CreateMode::OPEN: file = H5Fopen(fileName.string().c_str(), H5F_ACC_RDWR, plists.file_access); break;
+            case CreateMode::TRUNCATE: file = H5Fcreate(fileName.string().c_str(), H5F_ACC_TRUNC, plists.file_create, plists.file_access); break;
+            case CreateMode::RENAME: file = H5Fcreate(fileName.string().c_str(), H5F_ACC_EXCL, plists.file_create, plists.file_access); break;
+            default: throw std::runtime_error("File Mode not set. Choose  CreateMode::<OPEN|TRUNCATE|RENAME>");
+        }
+        if(file < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to create in-memory file: [" + fileName.string() + "]");
+        }
+        return file;
+    }
+
+    /*! Open a copy of a file image, e.g. from getFileImage, as an in-memory file */
+    [[nodiscard]] inline hid::h5f openFileImage(const void *buffer, size_t bytes, const AccessMode &accessMode = AccessMode::READWRITE) {
+        unsigned flags = accessMode == AccessMode::READWRITE ? H5LT_FILE_IMAGE_OPEN_RW : 0u;
+        // Without H5LT_FILE_IMAGE_DONT_COPY the buffer is copied, so it is never written to
+        hid_t file = H5LTopen_file_image(const_cast<void *>(buffer), bytes, flags);
+        if(file < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to open file image of " + std::to_string(bytes) + " bytes");
+        }
+        return file;
+    }
+
+    /*! A copy of the whole file as bytes, see H5Fget_file_image */
+    [[nodiscard]] inline std::vector<std::byte> getFileImage(const hid::h5f &file) {
+        unsigned intent = 0;
+        if(H5Fget_intent(file, &intent) < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to get the access mode of file");
+        }
+        if((intent & H5F_ACC_RDWR) != 0 and H5Fflush(file, H5F_SCOPE_LOCAL) < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to flush file before getting its image");
+        }
+        ssize_t bytes = H5Fget_file_image(file, nullptr, 0);
+        if(bytes < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to get the size of the file image");
+        }
+        std::vector<std::byte> image(static_cast<size_t>(bytes));
+        if(H5Fget_file_image(file, image.data(), image.size()) < 0) {
+            H5Eprint(H5E_DEFAULT, stderr);
+            throw std::runtime_error("Failed to get the file image");
+        }
+        H5PP_DEBUG("Got file image of {} bytes", image.size());
+        return image;
+    }
+
     inline std::pair<h5pp::fs::path, h5pp::fs::path> createFile(const h5pp::fs::path &filePath,
                                                                 const AccessMode &    accessMode = AccessMode::READWRITE,
                                                                 const CreateMode &    createMode = CreateMode::RENAME,
@@ -691,15 +1328,15 @@ namespace h5pp::hdf5 {
         fs::path fileName_result = filePath.filename();
         try {
             if(fs::create_directories(filePath_result.parent_path())) {
-                h5pp::logger::log->trace("Created directory: {}", filePath_result.parent_path().string());
+                H5PP_TRACE("Created directory: {}", filePath_result.parent_path().string());
             } else {
-                h5pp::logger::log->trace("Directory already exists: {}", filePath_result.parent_path().string());
+                H5PP_TRACE("Directory already exists: {}", filePath_result.parent_path().string());
             }
         } catch(std::exception &ex) { throw std::runtime_error("Failed to create directory: " + std::string(ex.what())); }
 
         switch(createMode) {
             case CreateMode::OPEN: {
-                h5pp::logger::log->debug("File mode [OPEN]: Opening file [{}]", filePath_result.string());
+                H5PP_DEBUG("File mode [OPEN]: Opening file [{}]", filePath_result.string());
                 try {
                     if(fileIsValid(filePath_result)) {
                         hid_t file;
@@ -721,7 +1358,7 @@ namespace h5pp::hdf5 {
                 break;
             }
             case CreateMode::TRUNCATE: {
-                h5pp::logger::log->debug("File mode [TRUNCATE]: Overwriting file if it exists: [{}]", filePath_result.string());
+                H5PP_DEBUG("File mode [TRUNCATE]: Overwriting file if it exists: [{}]", filePath_result.string());
                 try {
                     hid_t file = H5Fcreate(filePath_result.string().c_str(), H5F_ACC_TRUNC, plists.file_create, plists.file_access);
                     if(file < 0) {
@@ -735,7 +1372,7 @@ namespace h5pp::hdf5 {
             }
             case CreateMode::RENAME: {
                 try {
-                    h5pp::logger::log->debug("File mode [RENAME]: Finding new file name if previous file exists: [{}]", filePath_result.string());
+                    H5PP_DEBUG("File mode [RENAME]: Finding new file name if previous file exists: [{}]", filePath_result.string());
                     if(fileIsValid(filePath_result)) {
                         filePath_result = getAvailableFileName(filePath_result);
                         h5pp::logger::log->info("Previous file exists. Choosing new file name: [{}] ---> [{}]", fileName_result.string(), filePath_result.filename().string());
@@ -1,4 +1,5 @@
 #pragma once
+#include "h5ppLock.h"
 #include <cassert>
 #include <hdf5.h>
 #include <iostream>
@@ -26,6 +27,7 @@ namespace h5pp::hid {
 
         hid_base(const hid_base &other) {
             // Copy constructor
+            h5pp::lock::Guard guard;
             assert(other.val == 0 or valid(other.val) and "Given identifier must be valid");
             val = other.val; // Checks that we got a valid identifier through .value() (throws)
             if(valid(other.val))
@@ -35,6 +37,7 @@ namespace h5pp::hid {
 
         hid_base &operator=(const hid_t &rhs) {
             // Assignment from hid_t
+            h5pp::lock::Guard guard;
             assert(rhs == 0 or valid(rhs) and "Given identifier must be valid");
             if(not equal(rhs)) close(); // Drop current
             val = rhs;
@@ -46,6 +49,7 @@ namespace h5pp::hid {
 
         hid_base &operator=(const hid_base &rhs) {
             // Copy assignment
+            h5pp::lock::Guard guard;
             assert(rhs.val == 0 or valid(rhs.val) and "Given identifier must be valid");
             if(not equal(rhs.val)) close(); // Drop current
             val = rhs.val;
@@ -69,6 +73,7 @@ namespace h5pp::hid {
 
         auto refcount() const {
             if(zeroValueIsOK and val == 0) return 0;
+            h5pp::lock::Guard guard;
             if(valid()) {
                 auto refc = H5Iget_ref(val);
                 if(refc >= 0)
@@ -86,7 +91,8 @@ namespace h5pp::hid {
         std::string safe_print() { return std::to_string(val) + "(" + std::to_string(refcount()) + ")"; }
 
         [[nodiscard]] bool valid(const hid_t &other) const {
-            auto result = H5Iis_valid(other);
+            h5pp::lock::Guard guard;
+            auto              result = H5Iis_valid(other);
             assert(result >= 0 and "Error when determining validity of identifier");
             return result > 0;
         }
@@ -144,8 +150,12 @@ namespace h5pp::hid {
         using hid_base::hid_base;
         ~h5p() { close(); }
         [[nodiscard]] std::string tag() const final { return "h5p"; }
-        [[nodiscard]] bool        equal(const hid_t &rhs) const final { return (val > 0 and rhs > 0 and H5Pequal(val, rhs)) or val == rhs; }
+        [[nodiscard]] bool        equal(const hid_t &rhs) const final {
+            h5pp::lock::Guard guard;
+            return (val > 0 and rhs > 0 and H5Pequal(val, rhs)) or val == rhs;
+        }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Pclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -160,6 +170,7 @@ namespace h5pp::hid {
         [[nodiscard]] std::string tag() const final { return "h5s"; }
         [[nodiscard]] bool        equal(const hid_t &rhs) const final { return val == rhs; }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Sclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -172,8 +183,12 @@ namespace h5pp::hid {
         using hid_base::hid_base;
         ~h5t() { close(); }
         [[nodiscard]] std::string tag() const final { return "h5t"; }
-        [[nodiscard]] bool        equal(const hid_t &rhs) const final { return (valid(val) and valid(rhs) > 0 and H5Tequal(val, rhs)) or val == rhs; }
+        [[nodiscard]] bool        equal(const hid_t &rhs) const final {
+            h5pp::lock::Guard guard;
+            return (valid(val) and valid(rhs) > 0 and H5Tequal(val, rhs)) or val == rhs;
+        }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Tclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -188,6 +203,7 @@ namespace h5pp::hid {
         [[nodiscard]] std::string tag() const final { return "h5d"; }
         [[nodiscard]] bool        equal(const hid_t &rhs) const final { return val == rhs; }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Dclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -202,6 +218,7 @@ namespace h5pp::hid {
         [[nodiscard]] std::string tag() const final { return "h5g"; }
         [[nodiscard]] bool        equal(const hid_t &rhs) const final { return val == rhs; }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Gclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -216,6 +233,7 @@ namespace h5pp::hid {
         [[nodiscard]] std::string tag() const final { return "h5a"; }
         [[nodiscard]] bool        equal(const hid_t &rhs) const final { return val == rhs; }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Aclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -230,6 +248,7 @@ namespace h5pp::hid {
         [[nodiscard]] std::string tag() const final { return "h5o"; }
         [[nodiscard]] bool        equal(const hid_t &rhs) const final { return val == rhs; }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Oclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -244,6 +263,7 @@ namespace h5pp::hid {
         [[nodiscard]] std::string tag() const final { return "h5f"; }
         [[nodiscard]] bool        equal(const hid_t &rhs) const final { return val == rhs; }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) {
                 herr_t err = H5Fclose(val);
                 if(err < 0) H5Eprint(H5E_DEFAULT, stderr);
@@ -258,6 +278,7 @@ namespace h5pp::hid {
         [[nodiscard]] std::string tag() const final { return "h5e"; }
         [[nodiscard]] bool        equal(const hid_t &rhs) const final { return val == rhs; }
         void                      close() final {
+            h5pp::lock::Guard guard;
             if(valid()) H5Eclose_stack(val);
         }
     };
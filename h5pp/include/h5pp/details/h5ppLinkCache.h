@@ -0,0 +1,65 @@
+#pragma once
+#include "h5ppHdf5.h"
+#include "h5ppLogger.h"
+#include <hdf5.h>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+
+namespace h5pp {
+
+    /*!
+     \brief Remembers which links are known to exist in a file, so that repeated calls on the same paths skip H5Lexists on every prefix.
+
+     Only positive answers are stored: a path is added once it has been found, or created, and all of its prefixes are then known to be groups.
+     Links whose object type has not been looked up are stored as H5O_TYPE_UNKNOWN, and only answer whether the link exists.
+     Unknown paths give std::nullopt, meaning that the file has to be asked. The answers are meant to be passed on as the optional
+     linkExists/dsetExists arguments of the functions in h5pp::hdf5 and h5pp::scan.
+     h5pp never deletes links, so the cache only has to be cleared when the file itself is closed or replaced.
+     The cache has its own lock, so that threads can look up known links without waiting for the HDF5 lock held by other calls.
+    */
+    class LinkCache {
+        private:
+        std::map<std::string, H5O_type_t, std::less<>> links;
+        mutable std::shared_mutex                      mutex;
+
+        public:
+        [[nodiscard]] std::optional<bool> linkExists(std::string_view linkName) const {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if(links.find(linkName) != links.end()) return true;
+            return std::nullopt;
+        }
+
+        [[nodiscard]] std::optional<bool> dsetExists(std::string_view dsetName) const {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto                                it = links.find(dsetName);
+            if(it != links.end() and it->second == H5O_TYPE_DATASET) return true;
+            return std::nullopt;
+        }
+
+        void insert(std::string_view linkName, H5O_type_t linkType) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            auto                                it = links.find(linkName);
+            if(it != links.end()) {
+                if(linkType != H5O_TYPE_UNKNOWN) it->second = linkType;
+                return;
+            }
+            H5PP_TRACE("Caching link: [{}]", linkName);
+            for(const auto &subPath : h5pp::hdf5::pathCumulativeSplit(linkName, "/"))
+                if(subPath.size() < linkName.size()) links.emplace(subPath, H5O_TYPE_GROUP);
+            links.emplace(linkName, linkType);
+        }
+
+        void clear() {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            links.clear();
+        }
+
+        [[nodiscard]] size_t size() const {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return links.size();
+        }
+    };
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+
+namespace h5pp::lock {
+    /*
+     * HDF5 is only safe to call from several threads when built with --enable-threadsafe, and even then it serializes every call internally.
+     * h5pp therefore serializes its own calls into HDF5 behind this process-wide mutex, which works the same with either build.
+     * File and Dataset hold it for the whole of each call, so that the caches and counters of h5pp are only touched by one thread at a time.
+     * The hid:: wrappers take it too, since identifiers may be copied or closed outside of a call, e.g. when a dataset handle is destroyed.
+     * The mutex is recursive, so that calls may nest.
+     */
+    inline std::recursive_mutex hdf5;
+    inline thread_local size_t  depth = 0; /*!< Number of guards held by this thread */
+
+    /*! Holds the HDF5 lock for as long as it exists */
+    class Guard {
+        private:
+        std::lock_guard<std::recursive_mutex> lock;
+
+        public:
+        Guard() : lock(hdf5) { depth++; }
+        ~Guard() { depth--; }
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+    };
+
+    /*! Whether this thread holds the HDF5 lock. A thread that does must not wait for work that needs the lock on another thread */
+    [[nodiscard]] inline bool isHeld() { return depth > 0; }
+}
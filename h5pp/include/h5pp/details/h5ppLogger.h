@@ -15,9 +15,59 @@
     #include <memory>
 #endif
 
+/*
+ * Trace and debug messages on hot paths are written with the macros H5PP_TRACE and H5PP_DEBUG, which can be removed at compile time
+ * in the same way as SPDLOG_ACTIVE_LEVEL. Define H5PP_ACTIVE_LEVEL to the lowest level that is compiled in: 0 (trace) to 5 (critical).
+ * It defaults to 2 (info) in release builds, i.e. when NDEBUG is defined, and to 0 (trace) otherwise.
+ * When compiled in, the arguments are only evaluated if the message passes the level set at runtime.
+ */
+#ifndef H5PP_ACTIVE_LEVEL
+    #ifdef NDEBUG
+        #define H5PP_ACTIVE_LEVEL 2
+    #else
+        #define H5PP_ACTIVE_LEVEL 0
+    #endif
+#endif
+
+#if defined(H5PP_SPDLOG) && H5PP_ACTIVE_LEVEL <= 0
+    #define H5PP_TRACE(...)                                                                                                                              \
+        do {                                                                                                                                             \
+            if(h5pp::logger::log->should_log(spdlog::level::trace)) h5pp::logger::log->trace(__VA_ARGS__);                                             \
+        } while(false)
+#else
+    #define H5PP_TRACE(...) (void) 0
+#endif
+
+#if defined(H5PP_SPDLOG) && H5PP_ACTIVE_LEVEL <= 1
+    #define H5PP_DEBUG(...)                                                                                                                              \
+        do {                                                                                                                                             \
+            if(h5pp::logger::log->should_log(spdlog::level::debug)) h5pp::logger::log->debug(__VA_ARGS__);                                             \
+        } while(false)
+#else
+    #define H5PP_DEBUG(...) (void) 0
+#endif
+
 namespace h5pp::logger {
 #ifdef H5PP_SPDLOG
-    inline std::shared_ptr<spdlog::logger> log;
+    inline void setLogLevel(const std::shared_ptr<spdlog::logger> &logger, size_t levelZeroToFive) {
+        if(levelZeroToFive > 5) { throw std::runtime_error("Expected verbosity level integer in [0-5]. Got: " + std::to_string(levelZeroToFive)); }
+        logger->set_level(static_cast<spdlog::level::level_enum>(levelZeroToFive));
+    }
+
+    /*! Creates a logger that is owned by the caller instead of the spdlog registry, so that no registry lookup is needed */
+    inline std::shared_ptr<spdlog::logger> createLogger(const std::string &name, size_t levelZeroToFive = 2, bool timestamp = false) {
+        auto logger = std::make_shared<spdlog::logger>(name, std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+        if(timestamp)
+            logger->set_pattern("[%Y-%m-%d %H:%M:%S][%n]%^[%=8l]%$ %v");
+        else
+            logger->set_pattern("[%n]%^[%=8l]%$ %v");
+        setLogLevel(logger, levelZeroToFive);
+        return logger;
+    }
+
+    /*! The logger of the functions in h5pp::hdf5. Calls on a File point it to the logger of that File, and outside them,
+     *  e.g. on dataset handles, it is this default one, at level info unless changed with setLogLevel */
+    inline std::shared_ptr<spdlog::logger> log = createLogger("h5pp");
 
     inline void enableTimestamp() { log->set_pattern("[%Y-%m-%d %H:%M:%S][%n]%^[%=8l]%$ %v"); }
     inline void disableTimestamp() { log->set_pattern("[%n]%^[%=8l]%$ %v"); }
@@ -66,11 +116,15 @@ namespace h5pp::logger {
         void        critical(Args... args) const {}
         std::string name() const { return ""; }
     };
-    inline std::shared_ptr<DummyLogger> log;
+    inline std::shared_ptr<DummyLogger> log = std::make_shared<DummyLogger>();
 
     inline void enableTimestamp() {}
     inline void disableTimestamp() {}
     inline void setLogLevel([[maybe_unused]] size_t levelZeroToFive) {}
+    inline void setLogLevel([[maybe_unused]] const std::shared_ptr<DummyLogger> &logger, [[maybe_unused]] size_t levelZeroToFive) {}
+    inline std::shared_ptr<DummyLogger> createLogger([[maybe_unused]] const std::string &name, [[maybe_unused]] size_t levelZeroToFive = 2, [[maybe_unused]] bool timestamp = false) {
+        return std::make_shared<DummyLogger>();
+    }
     inline void setLogger([[maybe_unused]] const std::string &name, [[maybe_unused]] size_t levelZeroToFive = 2, [[maybe_unused]] bool timestamp = false) {}
     template<typename... Args>
     auto format(const std::string &first_param, Args... args) {
@@ -0,0 +1,106 @@
+#pragma once
+#include "h5ppFilesystem.h"
+#include <cstddef>
+#include <hdf5.h>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #define H5PP_HAS_MMAP
+#endif
+
+namespace h5pp {
+
+    /*!
+     \brief A read-only view of the elements of a dataset, obtained with h5pp::File::mapDataset.
+
+     When possible the view maps the raw data of the dataset straight from the file with mmap, so that nothing is copied
+     and the page cache of the operating system loads the data on demand. Otherwise the dataset is read into a buffer
+     owned by the view, and isMapped() returns false. Elements are in row-major order, as on file.
+
+     A mapping stays valid after the File is destroyed. It shows changes made to the dataset in place, and reading it
+     after the file has been truncated or replaced on disk is an error (SIGBUS).
+    */
+    template<typename T>
+    class MappedDataset {
+        private:
+        std::vector<T>       buffer;            /*!< The data, when not mapped */
+        void *               mapping      = nullptr;
+        size_t               mappingBytes = 0;
+        const T *            data_        = nullptr;
+        size_t               size_        = 0;
+        std::vector<hsize_t> dims_;
+
+        void unmap() {
+#ifdef H5PP_HAS_MMAP
+            if(mapping != nullptr) munmap(mapping, mappingBytes);
+#endif
+            mapping      = nullptr;
+            mappingBytes = 0;
+        }
+
+        public:
+        MappedDataset() = default;
+
+        /*! A view of data that has been read into memory */
+        MappedDataset(std::vector<T> &&data, std::vector<hsize_t> dims)
+            : buffer(std::move(data)), data_(buffer.data()), size_(buffer.size()), dims_(std::move(dims)) {}
+
+        ~MappedDataset() { unmap(); }
+        MappedDataset(const MappedDataset &) = delete;
+        MappedDataset &operator=(const MappedDataset &) = delete;
+        MappedDataset(MappedDataset &&other) noexcept { *this = std::move(other); }
+        MappedDataset &operator=(MappedDataset &&other) noexcept {
+            if(&other == this) return *this;
+            unmap();
+            // Moving the vector keeps its data where it is, so data_ stays valid
+            buffer       = std::move(other.buffer);
+            mapping      = std::exchange(other.mapping, nullptr);
+            mappingBytes = std::exchange(other.mappingBytes, 0);
+            data_        = std::exchange(other.data_, nullptr);
+            size_        = std::exchange(other.size_, 0);
+            dims_        = std::move(other.dims_);
+            return *this;
+        }
+
+        /*! Map the elements stored from byte offset in a file. Returns nothing if the platform has no mmap, or if the mapping
+         *  fails or would leave the elements misaligned, in which case the caller should read the data instead */
+        [[nodiscard]] static std::optional<MappedDataset> tryMap(const fs::path &filePath, haddr_t offset, std::vector<hsize_t> dims) {
+#ifdef H5PP_HAS_MMAP
+            size_t size = std::accumulate(dims.begin(), dims.end(), static_cast<size_t>(1), std::multiplies<>());
+            if(size == 0 or offset % alignof(T) != 0) return std::nullopt;
+            auto  pageSize      = static_cast<haddr_t>(sysconf(_SC_PAGESIZE));
+            auto  alignedOffset = offset - offset % pageSize; // mmap needs an offset aligned to pages
+            auto  bytes         = static_cast<size_t>(offset - alignedOffset) + size * sizeof(T);
+            int   fd            = ::open(filePath.c_str(), O_RDONLY);
+            if(fd < 0) return std::nullopt;
+            void *mapping = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(alignedOffset));
+            ::close(fd); // The mapping keeps its own reference to the file
+            if(mapping == MAP_FAILED) return std::nullopt;
+            MappedDataset view;
+            view.mapping      = mapping;
+            view.mappingBytes = bytes;
+            view.data_        = reinterpret_cast<const T *>(static_cast<const std::byte *>(mapping) + (offset - alignedOffset));
+            view.size_        = size;
+            view.dims_        = std::move(dims);
+            return view;
+#else
+            return std::nullopt;
+#endif
+        }
+
+        [[nodiscard]] const T *                   data() const { return data_; }
+        [[nodiscard]] size_t                      size() const { return size_; }
+        [[nodiscard]] bool                        empty() const { return size_ == 0; }
+        [[nodiscard]] const std::vector<hsize_t> &dims() const { return dims_; }
+        [[nodiscard]] bool                        isMapped() const { return mapping != nullptr; }
+        [[nodiscard]] const T *                   begin() const { return data_; }
+        [[nodiscard]] const T *                   end() const { return data_ + size_; }
+        const T &                                 operator[](size_t idx) const { return data_[idx]; }
+    };
+}
@@ -1,8 +1,20 @@
 #pragma once
 #include "h5ppHid.h"
 #include <hdf5.h>
+#include <stdexcept>
 
 namespace h5pp {
+    /*!
+     * Settings for the raw data chunk cache of HDF5, see H5Pset_chunk_cache.
+     * Each open dataset gets its own cache, which holds up to nbytes of uncompressed chunks.
+     * The defaults are those of HDF5 (1 MiB, 521 slots). Use h5pp::utils::getDefaultChunkCache to size it from the chunk dimensions of a dataset.
+     * */
+    struct ChunkCache {
+        size_t nbytes = 1024 * 1024; /*!< Total size of the cache in bytes */
+        size_t nslots = 521;         /*!< Number of hash table slots. Should be a prime ~100 times the number of chunks that fit in nbytes */
+        double w0     = 0.75;        /*!< Preemption policy in [0,1]. Use 1.0 if chunks are read or written only once */
+    };
+
     /*!
      * Property lists that describe policies for common tasks in HDF5.
      * Note that we do not include dataset property lists here because
@@ -17,6 +29,9 @@ namespace h5pp {
         hid::h5p group_create = H5P_DEFAULT; // H5Pcreate(H5P_GROUP_CREATE);
         hid::h5p group_access = H5P_DEFAULT; // H5Pcreate(H5P_GROUP_ACCESS);
         hid::h5p dset_xfer    = H5P_DEFAULT; // H5Pcreate(H5P_DATASET_XFER);
+        hid::h5p dset_access  = H5P_DEFAULT; // H5Pcreate(H5P_DATASET_ACCESS). Used when opening or creating datasets
+        size_t   readThreads  = 1;           // Threads that decompress the chunks of whole-dataset reads, see h5pp::hdf5::readDatasetParallel. 1 leaves it to H5Dread
+        size_t   writeThreads = 1;           // Threads that compress the chunks of whole-dataset writes, see h5pp::hdf5::writeDatasetParallel. 1 leaves it to H5Dwrite
 
         PropertyLists() {
             // Set default to create missing intermediate groups if they do not exist
@@ -24,5 +39,38 @@ namespace h5pp {
             link_create = H5Pcreate(H5P_LINK_CREATE);
             H5Pset_create_intermediate_group(link_create, 1);
         }
+
+        /*! Set the default chunk cache for all datasets in files opened with these property lists.
+         *  Note that property lists are shared between copies, so we always modify a fresh copy. */
+        void setChunkCache(const ChunkCache &cache) {
+            hid::h5p plist = file_access == H5P_DEFAULT ? H5Pcreate(H5P_FILE_ACCESS) : H5Pcopy(file_access);
+            // The number of metadata cache elements (second argument) is ignored by HDF5 since 1.8
+            if(H5Pset_cache(plist, 0, cache.nslots, cache.nbytes, cache.w0) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to set chunk cache on file access property list");
+            }
+            file_access = plist;
+        }
+
+        /*! Keep files in memory with the core driver of HDF5, see H5Pset_fapl_core. Memory grows in steps of increment bytes.
+         *  With a backing store, the file is written to disk when it is flushed or closed, otherwise it is discarded when closed */
+        void setCoreDriver(size_t increment, bool backingStore) {
+            hid::h5p plist = file_access == H5P_DEFAULT ? H5Pcreate(H5P_FILE_ACCESS) : H5Pcopy(file_access);
+            if(H5Pset_fapl_core(plist, increment, backingStore) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to set the core driver on file access property list");
+            }
+            file_access = plist;
+        }
+
+        /*! Set the chunk cache for datasets opened or created with these property lists, overriding the file-wide default */
+        void setDatasetChunkCache(const ChunkCache &cache) {
+            hid::h5p plist = dset_access == H5P_DEFAULT ? H5Pcreate(H5P_DATASET_ACCESS) : H5Pcopy(dset_access);
+            if(H5Pset_chunk_cache(plist, cache.nslots, cache.nbytes, cache.w0) < 0) {
+                H5Eprint(H5E_DEFAULT, stderr);
+                throw std::runtime_error("Failed to set chunk cache on dataset access property list");
+            }
+            dset_access = plist;
+        }
     };
 }
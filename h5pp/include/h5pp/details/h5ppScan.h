@@ -1,3 +1,4 @@
+#pragma once
 #include "h5ppAttributeProperties.h"
 #include "h5ppConstants.h"
 #include "h5ppHdf5.h"
@@ -9,11 +10,12 @@ namespace h5pp::scan {
                                                              const std::optional<bool> dsetExists = std::nullopt,
                                                              const PropertyLists &     plists     = PropertyLists()) {
         // Use this function to get info from existing datasets on file.
-        h5pp::logger::log->trace("Reading properties of dataset: [{}] from file", dsetName);
+        H5PP_TRACE("Reading properties of dataset: [{}] from file", dsetName);
         h5pp::DatasetProperties dsetProps;
         dsetProps.dsetName   = dsetName;
         dsetProps.dsetExists = h5pp::hdf5::checkIfDatasetExists(file, dsetName, dsetExists, plists);
         if(dsetProps.dsetExists.value()) {
+            dsetProps.plist_dset_access = plists.dset_access;
             dsetProps.dataSet   = h5pp::hdf5::openObject<hid::h5d>(file, dsetProps.dsetName.value(), dsetProps.dsetExists, dsetProps.plist_dset_access);
             dsetProps.dataType  = H5Dget_type(dsetProps.dataSet);
             dsetProps.dataSpace = H5Dget_space(dsetProps.dataSet);
@@ -38,6 +40,25 @@ namespace h5pp::scan {
         return dsetProps;
     }
 
+    template<typename DataType>
+    h5pp::DatasetProperties getDatasetProperties_modify(const hid::h5f &          file,
+                                                        std::string_view          dsetName,
+                                                        const std::optional<bool> dsetExists = std::nullopt,
+                                                        const std::optional<bool> typesMatch = std::nullopt,
+                                                        const PropertyLists &     plists     = PropertyLists()) {
+        // Use this function to get info from an existing dataset that is about to be partially written, e.g. appended to.
+        // Unlike overwrites, the dataset keeps its dimensions (or grows), so we only need to check that the given type is compatible.
+        auto dsetProps = getDatasetProperties_read(file, dsetName, dsetExists, plists);
+        if(not dsetProps.dsetExists.value()) throw std::runtime_error("Dataset does not exist: [" + std::string(dsetName) + "]");
+        if(dsetProps.ndims != h5pp::utils::getRank<DataType>())
+            throw std::runtime_error("Number of dimensions in existing dataset (" + std::to_string(dsetProps.ndims.value()) + ") differ from dimensions in given data (" +
+                                     std::to_string(h5pp::utils::getRank<DataType>()) + ")");
+        if(not h5pp::hdf5::checkIfTypesMatch<DataType>(dsetProps.dataType, typesMatch))
+            throw std::runtime_error("Given datatype does not match the type of an existing dataset: " + dsetProps.dsetName.value());
+        dsetProps.dataType = h5pp::utils::getH5Type<DataType>();
+        return dsetProps;
+    }
+
     template<typename DataType>
     h5pp::DatasetProperties getDatasetProperties_bootstrap(hid::h5f &                                file,
                                                            std::string_view                          dsetName,
@@ -46,8 +67,11 @@ namespace h5pp::scan {
                                                            const std::optional<H5D_layout_t>         desiredLayout           = std::nullopt,
                                                            const std::optional<std::vector<hsize_t>> desiredChunkDims        = std::nullopt,
                                                            const std::optional<unsigned int>         desiredCompressionLevel = std::nullopt,
+                                                           const std::optional<std::vector<Filter>> &desiredFilters          = std::nullopt,
+                                                           const std::optional<size_t>               desiredChunkBytes       = std::nullopt,
+                                                           const std::optional<hid::h5p> &           dsetCreatePlist         = std::nullopt,
                                                            const PropertyLists &                     plists                  = PropertyLists()) {
-        h5pp::logger::log->trace("Inferring properties for future dataset: [{}] from type", dsetName);
+        H5PP_TRACE("Inferring properties for future dataset: [{}] from type", dsetName);
 
         // Use this function to detect info from the given DataType, to later create a dataset from scratch.
         h5pp::DatasetProperties dataProps;
@@ -61,7 +85,9 @@ namespace h5pp::scan {
         dataProps.dataType  = h5pp::utils::getH5Type<DataType>();                   // We use our own data-type matching to avoid any confusion
         dataProps.size      = h5pp::utils::setStringSize(data, dataProps.dataType); // This only affects strings
         dataProps.layout    = h5pp::utils::decideLayout(dataProps.bytes.value(), desiredLayout);
-        dataProps.chunkDims = h5pp::utils::getDefaultChunkDimensions(dataProps.size.value(), dataProps.dims.value(), desiredChunkDims);
+        // Chunks should fit in the chunk cache, otherwise HDF5 bypasses the cache
+        size_t chunkBytes   = std::min(desiredChunkBytes.value_or(h5pp::constants::defaultChunkBytes), h5pp::hdf5::getChunkCacheBytes(plists));
+        dataProps.chunkDims = h5pp::utils::getDefaultChunkDimensions(dataProps.dims.value(), H5Tget_size(dataProps.dataType), desiredChunkDims, chunkBytes);
         dataProps.memSpace  = h5pp::utils::getMemSpace(dataProps.size.value(), dataProps.ndims.value(), dataProps.dims.value());
         dataProps.dataSpace = h5pp::utils::getDataSpace(dataProps.size.value(), dataProps.ndims.value(), dataProps.dims.value(), dataProps.layout.value());
 
@@ -70,9 +96,18 @@ namespace h5pp::scan {
         } else {
             dataProps.compressionLevel = 0;
         }
-        dataProps.plist_dset_create = H5Pcreate(H5P_DATASET_CREATE);
-        h5pp::hdf5::setDatasetCreationPropertyLayout(dataProps);
-        h5pp::hdf5::setDatasetCreationPropertyCompression(dataProps);
+        dataProps.filters           = desiredFilters;
+        dataProps.plist_dset_access = plists.dset_access;
+        if(dsetCreatePlist and dataProps.layout.value() != H5D_CHUNKED and H5Pget_layout(dsetCreatePlist.value()) == dataProps.layout.value()) {
+            // Compact and contiguous layouts take no settings from the data, and ignore compression and filters, so a list made for an earlier dataset can be reused
+            dataProps.plist_dset_create = dsetCreatePlist.value();
+        } else {
+            dataProps.plist_dset_create = H5Pcreate(H5P_DATASET_CREATE);
+            h5pp::hdf5::setDatasetCreationPropertyLayout(dataProps);
+            // Deflate goes after the given filters, so that e.g. shuffle or scale-offset prepare the data for it
+            h5pp::hdf5::setDatasetCreationPropertyFilters(dataProps);
+            h5pp::hdf5::setDatasetCreationPropertyCompression(dataProps);
+        }
         h5pp::hdf5::setDataSpaceExtent(dataProps);
         return dataProps;
     }
@@ -85,8 +120,12 @@ namespace h5pp::scan {
                                                        const std::optional<H5D_layout_t>         desiredLayout           = std::nullopt,
                                                        const std::optional<std::vector<hsize_t>> desiredChunkDims        = std::nullopt,
                                                        const std::optional<unsigned int>         desiredCompressionLevel = std::nullopt,
+                                                       const std::optional<std::vector<Filter>> &desiredFilters          = std::nullopt,
+                                                       const std::optional<size_t>               desiredChunkBytes       = std::nullopt,
+                                                       const std::optional<bool>                 typesMatch              = std::nullopt,
+                                                       const std::optional<hid::h5p> &           dsetCreatePlist         = std::nullopt,
                                                        const PropertyLists &                     plists                  = PropertyLists()) {
-        h5pp::logger::log->trace("Reading properties for writing into dataset: [{}]", dsetName);
+        H5PP_TRACE("Reading properties for writing into dataset: [{}]", dsetName);
 
         if(not dsetExists) dsetExists = h5pp::hdf5::checkIfLinkExists(file, dsetName, dsetExists, plists);
 
@@ -99,7 +138,7 @@ namespace h5pp::scan {
                 throw std::runtime_error("Number of dimensions in existing dataset (" + std::to_string(dsetProps.ndims.value()) + ") differ from dimensions in given data (" +
                                          std::to_string(h5pp::utils::getRank<DataType>()) + ")");
 
-            if(not h5pp::hdf5::checkEqualTypesRecursive(dsetProps.dataType, h5pp::utils::getH5Type<DataType>()))
+            if(not h5pp::hdf5::checkIfTypesMatch<DataType>(dsetProps.dataType, typesMatch))
                 throw std::runtime_error("Given datatype does not match the type of an existing dataset: " + dsetProps.dsetName.value());
 
             h5pp::DatasetProperties dataProps;
@@ -111,7 +150,7 @@ namespace h5pp::scan {
             dataProps.dataType          = h5pp::utils::getH5Type<DataType>();
             dataProps.ndims             = h5pp::utils::getRank<DataType>();
             dataProps.chunkDims         = dsetProps.chunkDims;
-            dataProps.plist_dset_access = dsetProps.plist_dset_create;
+            dataProps.plist_dset_access = dsetProps.plist_dset_access;
 
             // The rest we can inferr directly from the data
             dataProps.dims  = h5pp::utils::getDimensions(data);
@@ -140,7 +179,7 @@ namespace h5pp::scan {
         } else {
             // We enter write-from-scratch mode
             // Use this function to detect info from the given DataType, to later create a dataset from scratch.
-            return getDatasetProperties_bootstrap(file, dsetName, data, dsetExists, desiredLayout, desiredChunkDims, desiredCompressionLevel, plists);
+            return getDatasetProperties_bootstrap(file, dsetName, data, dsetExists, desiredLayout, desiredChunkDims, desiredCompressionLevel, desiredFilters, desiredChunkBytes, dsetCreatePlist, plists);
         }
     }
 
@@ -151,7 +190,7 @@ namespace h5pp::scan {
                                                                  const std::optional<bool> linkExists = std::nullopt,
                                                                  const PropertyLists &     plists     = PropertyLists()) {
         // Use this function to get info from existing attributes on file.
-        h5pp::logger::log->trace("Reading properties of attribute: [{}] in link [{}] from file", attrName, linkName);
+        H5PP_TRACE("Reading properties of attribute: [{}] in link [{}] from file", attrName, linkName);
         h5pp::AttributeProperties attrProps;
         attrProps.linkExists = h5pp::hdf5::checkIfLinkExists(file, linkName, linkExists, plists);
         attrProps.attrExists = h5pp::hdf5::checkIfAttributeExists(file, linkName, attrName, attrProps.linkExists, attrExists, plists);
@@ -185,7 +224,7 @@ namespace h5pp::scan {
                                                                       std::optional<bool>  linkExists = std::nullopt,
                                                                       const PropertyLists &plists     = PropertyLists()) {
         // Use this function to get info from existing datasets on file.
-        h5pp::logger::log->trace("Bootstrapping properties for writing attribute [{}] into link [{}]", attrName, linkName);
+        H5PP_TRACE("Bootstrapping properties for writing attribute [{}] into link [{}]", attrName, linkName);
         h5pp::AttributeProperties dataProps;
         dataProps.linkExists = h5pp::hdf5::checkIfLinkExists(file, linkName, linkExists, plists);
         dataProps.attrExists = h5pp::hdf5::checkIfAttributeExists(file, linkName, attrName, dataProps.linkExists, attrExists, plists);
@@ -211,23 +250,24 @@ namespace h5pp::scan {
                                                                   std::string_view     linkName,
                                                                   std::optional<bool>  attrExists = std::nullopt,
                                                                   std::optional<bool>  linkExists = std::nullopt,
+                                                                  std::optional<bool>  typesMatch = std::nullopt,
                                                                   const PropertyLists &plists     = PropertyLists()) {
         // Use this function to get info from existing datasets on file.
-        h5pp::logger::log->trace("Reading properties for writing into attribute: [{}] on link [{}]", attrName, linkName);
+        H5PP_TRACE("Reading properties for writing into attribute: [{}] on link [{}]", attrName, linkName);
 
         linkExists = h5pp::hdf5::checkIfLinkExists(file, linkName, linkExists, plists);
         attrExists = h5pp::hdf5::checkIfAttributeExists(file, linkName, attrName, linkExists, std::nullopt, plists);
 
         if(linkExists.value() and attrExists.value()) {
             // We enter overwrite mode
-            h5pp::logger::log->trace("Attribute [{}] exists in link [{}]", attrName, linkName);
+            H5PP_TRACE("Attribute [{}] exists in link [{}]", attrName, linkName);
             auto attrProps = getAttributeProperties_read(file, attrName, linkName, attrExists, linkExists, plists);
             // Sanity check
             if(attrProps.ndims != h5pp::utils::getRank<DataType>())
                 throw std::runtime_error("Number of dimensions in existing dataset (" + std::to_string(attrProps.ndims.value()) + ") differ from dimensions in given data (" +
                                          std::to_string(h5pp::utils::getRank<DataType>()) + ")");
 
-            if(not h5pp::hdf5::checkEqualTypesRecursive(attrProps.dataType, h5pp::utils::getH5Type<DataType>()))
+            if(not h5pp::hdf5::checkIfTypesMatch<DataType>(attrProps.dataType, typesMatch))
                 throw std::runtime_error("Given datatype does not match the type of an existing dataset: " + attrProps.linkName.value());
 
             h5pp::AttributeProperties dataProps;
@@ -235,6 +275,7 @@ namespace h5pp::scan {
             dataProps.attributeId       = attrProps.attributeId;
             dataProps.linkObject        = attrProps.linkObject;
             dataProps.attrName          = attrProps.attrName;
+            dataProps.linkName          = attrProps.linkName;
             dataProps.linkExists        = attrProps.linkExists;
             dataProps.attrExists        = attrProps.attrExists;
             dataProps.dataType          = h5pp::utils::getH5Type<DataType>();
@@ -251,7 +292,7 @@ namespace h5pp::scan {
             return dataProps;
 
         } else {
-            h5pp::logger::log->trace("Attribute [{}] does not exists in link [{}]", attrName, linkName);
+            H5PP_TRACE("Attribute [{}] does not exists in link [{}]", attrName, linkName);
             return getAttributeProperties_bootstrap(file, data, attrName, linkName, attrExists, linkExists, plists);
         }
     }
@@ -0,0 +1,98 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+
+namespace h5pp {
+
+    /*!
+     \brief Counts, cumulative time and bytes of the operations made by a File, collected when enabled with File::setCollectStats.
+
+     Timings are nested: type checks are part of property scans, and the writes and reads of tiled Eigen objects are
+     counted once per tile. HDF5 has no public statistics for the chunk cache, so the hit rate of the metadata cache is given instead.
+    */
+    struct IoStats {
+        struct Timing {
+            size_t   count       = 0;
+            uint64_t nanoseconds = 0;
+            size_t   bytes       = 0;
+        };
+        Timing                fileOpens;            /*!< Calls to H5Fopen. In keep-open mode the handle is reused instead */
+        Timing                propertyScans;        /*!< Lookups of the properties of datasets and attributes before reading or writing */
+        Timing                typeChecks;           /*!< Comparisons between C++ types and the types of existing datasets and attributes */
+        Timing                datasetCreates;       /*!< Calls to H5Dcreate */
+        Timing                datasetWrites;        /*!< Calls to H5Dwrite, including any type conversion made by HDF5 */
+        Timing                datasetReads;         /*!< Calls to H5Dread, including any type conversion made by HDF5 */
+        Timing                attributeWrites;      /*!< Attribute writes, including the conversion of column-major Eigen objects */
+        Timing                attributeReads;       /*!< Attribute reads, including the conversion of column-major Eigen objects */
+        Timing                layoutConversions;    /*!< Conversions between column-major Eigen datasets and the row-major layout on file */
+        std::optional<double> metadataCacheHitRate; /*!< Hit rate of the metadata cache of the persistent file handle, see H5Fget_mdc_hit_rate */
+
+        [[nodiscard]] std::string toJson() const {
+            std::ostringstream json;
+            auto               timing = [&json](const char *name, const Timing &t) {
+                json << "\"" << name << "\": {\"count\": " << t.count << ", \"nanoseconds\": " << t.nanoseconds << ", \"bytes\": " << t.bytes << "}, ";
+            };
+            json << "{";
+            timing("fileOpens", fileOpens);
+            timing("propertyScans", propertyScans);
+            timing("typeChecks", typeChecks);
+            timing("datasetCreates", datasetCreates);
+            timing("datasetWrites", datasetWrites);
+            timing("datasetReads", datasetReads);
+            timing("attributeWrites", attributeWrites);
+            timing("attributeReads", attributeReads);
+            timing("layoutConversions", layoutConversions);
+            json << "\"metadataCacheHitRate\": ";
+            if(metadataCacheHitRate)
+                json << metadataCacheHitRate.value();
+            else
+                json << "null";
+            json << "}";
+            return json.str();
+        }
+    };
+}
+
+namespace h5pp::stats {
+    inline thread_local IoStats *active = nullptr; /*!< Statistics of the File whose call is in progress on this thread, or nullptr if it collects none */
+
+    /*! Makes the statistics of a File active for the duration of one of its calls. Nested scopes restore the outer one */
+    class Scope {
+        private:
+        IoStats *previous;
+
+        public:
+        explicit Scope(IoStats *stats) : previous(active) { active = stats; }
+        ~Scope() { active = previous; }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    /*! Adds the time until stop() or destruction, and the given bytes, to a timing of the given or active statistics. Does nothing if there are none */
+    class Timer {
+        private:
+        IoStats::Timing *                                  timing = nullptr;
+        std::chrono::time_point<std::chrono::steady_clock> start;
+
+        public:
+        explicit Timer(IoStats::Timing IoStats::*member, size_t bytes = 0) : Timer(active, member, bytes) {}
+        Timer(IoStats *stats, IoStats::Timing IoStats::*member, size_t bytes = 0) {
+            if(stats == nullptr) return;
+            timing = &(stats->*member);
+            timing->count++;
+            timing->bytes += bytes;
+            start = std::chrono::steady_clock::now();
+        }
+        ~Timer() { stop(); }
+        Timer(const Timer &) = delete;
+        Timer &operator=(const Timer &) = delete;
+        void   stop() {
+            if(timing == nullptr) return;
+            timing->nanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            timing = nullptr;
+        }
+    };
+}
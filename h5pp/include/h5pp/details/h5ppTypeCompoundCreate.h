@@ -5,7 +5,13 @@
 #include "h5ppTypeSfinae.h"
 #include <complex>
 
+namespace h5pp::utils {
+    template<typename DataType>
+    [[nodiscard]] hid::h5t getH5Type();
+}
+
 namespace h5pp::type::compound::Create {
+    // These are called once per type by h5pp::utils::getH5Type, which shares the result through h5pp::type::registry
 
     template<typename T>
     [[nodiscard]] hid::h5t createComplexType() {
@@ -17,7 +23,7 @@ namespace h5pp::type::compound::Create {
             H5Eprint(H5E_DEFAULT, stderr);
             throw std::runtime_error("Failed to insert x or y in new complex type: \n real " + std::to_string(errr) + "\n imag " + std::to_string(erri));
         }
-        return H5Tcopy(NEW_COMPLEX_TYPE);
+        return NEW_COMPLEX_TYPE;
     }
 
     template<typename T>
@@ -50,66 +56,3 @@ namespace h5pp::type::compound::Create {
     }
 
 }
-
-namespace h5pp::type::compound {
-
-    inline void initTypes() {
-        H5T_COMPLEX_INT    = Create::createComplexType<int>();
-        H5T_COMPLEX_LONG   = Create::createComplexType<long>();
-        H5T_COMPLEX_LLONG  = Create::createComplexType<long long>();
-        H5T_COMPLEX_UINT   = Create::createComplexType<unsigned int>();
-        H5T_COMPLEX_UINT   = Create::createComplexType<unsigned int>();
-        H5T_COMPLEX_ULONG  = Create::createComplexType<unsigned long>();
-        H5T_COMPLEX_ULLONG = Create::createComplexType<unsigned long long>();
-        H5T_COMPLEX_DOUBLE = Create::createComplexType<double>();
-        H5T_COMPLEX_FLOAT  = Create::createComplexType<float>();
-
-        H5T_SCALAR2_INT    = Create::createScalar2Type<int>();
-        H5T_SCALAR2_LONG   = Create::createScalar2Type<long>();
-        H5T_SCALAR2_LLONG  = Create::createScalar2Type<long long>();
-        H5T_SCALAR2_UINT   = Create::createScalar2Type<unsigned int>();
-        H5T_SCALAR2_ULONG  = Create::createScalar2Type<unsigned long>();
-        H5T_SCALAR2_ULLONG = Create::createScalar2Type<unsigned long long>();
-        H5T_SCALAR2_DOUBLE = Create::createScalar2Type<double>();
-        H5T_SCALAR2_FLOAT  = Create::createScalar2Type<float>();
-
-        H5T_SCALAR3_INT    = Create::createScalar3Type<int>();
-        H5T_SCALAR3_LONG   = Create::createScalar3Type<long>();
-        H5T_SCALAR3_LLONG  = Create::createScalar3Type<long long>();
-        H5T_SCALAR3_UINT   = Create::createScalar3Type<unsigned int>();
-        H5T_SCALAR3_ULONG  = Create::createScalar3Type<unsigned long>();
-        H5T_SCALAR3_ULLONG = Create::createScalar3Type<unsigned long long>();
-        H5T_SCALAR3_DOUBLE = Create::createScalar3Type<double>();
-        H5T_SCALAR3_FLOAT  = Create::createScalar3Type<float>();
-    }
-
-    inline void closeTypes() {
-        H5Tclose(H5T_COMPLEX_INT);
-        H5Tclose(H5T_COMPLEX_LONG);
-        H5Tclose(H5T_COMPLEX_LLONG);
-        H5Tclose(H5T_COMPLEX_UINT);
-        H5Tclose(H5T_COMPLEX_ULONG);
-        H5Tclose(H5T_COMPLEX_ULLONG);
-        H5Tclose(H5T_COMPLEX_DOUBLE);
-        H5Tclose(H5T_COMPLEX_FLOAT);
-
-        H5Tclose(H5T_SCALAR2_INT);
-        H5Tclose(H5T_SCALAR2_LONG);
-        H5Tclose(H5T_SCALAR2_LLONG);
-        H5Tclose(H5T_SCALAR2_UINT);
-        H5Tclose(H5T_SCALAR2_ULONG);
-        H5Tclose(H5T_SCALAR2_ULLONG);
-        H5Tclose(H5T_SCALAR2_DOUBLE);
-        H5Tclose(H5T_SCALAR2_FLOAT);
-
-        H5Tclose(H5T_SCALAR3_INT);
-        H5Tclose(H5T_SCALAR3_LONG);
-        H5Tclose(H5T_SCALAR3_LLONG);
-        H5Tclose(H5T_SCALAR3_UINT);
-        H5Tclose(H5T_SCALAR3_ULONG);
-        H5Tclose(H5T_SCALAR3_ULLONG);
-        H5Tclose(H5T_SCALAR3_DOUBLE);
-        H5Tclose(H5T_SCALAR3_FLOAT);
-    }
-
-}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#include "h5ppHid.h"
+#include <hdf5.h>
+#include <optional>
+#include <vector>
+
+namespace h5pp::type::registry {
+    /*
+     * HDF5 types for C++ types are created once, on first use, and then shared between calls.
+     * Handing out a shared type only increments its reference count, which is much cheaper than H5Tcopy.
+     * Shared types must never be modified. Types that are modified after creation, such as strings whose size is set per call, are not registered.
+     */
+
+    inline std::vector<std::optional<hid::h5t> *> registeredTypes; // The types created so far, so that they can be closed
+
+    template<typename T>
+    inline std::optional<hid::h5t> registeredType; // One slot per C++ type, selected at compile time
+
+    template<typename T, typename Creator>
+    [[nodiscard]] const hid::h5t &getType(Creator create) {
+        auto &type = registeredType<T>;
+        if(not type) {
+            type = create();
+            registeredTypes.push_back(&type);
+        }
+        return type.value();
+    }
+
+    template<typename T>
+    [[nodiscard]] const hid::h5t &getType(hid_t predefinedType) {
+        // Predefined types such as H5T_NATIVE_INT are immutable and can't be closed, so we register a copy
+        return getType<T>([predefinedType]() -> hid::h5t { return H5Tcopy(predefinedType); });
+    }
+
+    inline void closeTypes() {
+        // Types still held elsewhere, e.g. by a dataset handle, stay valid until released there
+        for(auto *type : registeredTypes) type->reset();
+        registeredTypes.clear();
+    }
+}
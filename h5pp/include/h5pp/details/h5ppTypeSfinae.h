@@ -1,6 +1,7 @@
 #pragma once
 #include "h5ppEigen.h"
 #include "h5ppLogger.h"
+#include "h5ppPtrWrapper.h"
 #include "h5ppTypeCompound.h"
 #include <type_traits>
 
@@ -118,6 +119,13 @@ namespace h5pp::type::sfinae {
     template<typename T>
     inline constexpr bool is_std_array_v = is_std_array<T>::value;
 
+    template<typename T>
+    struct is_ptr_wrapper : public std::false_type {};
+    template<typename PointerType, size_t N>
+    struct is_ptr_wrapper<h5pp::PtrWrapper<PointerType, N>> : public std::true_type {};
+    template<typename T>
+    inline constexpr bool is_ptr_wrapper_v = is_ptr_wrapper<T>::value;
+
     template<typename T>
     struct is_text {
         private:
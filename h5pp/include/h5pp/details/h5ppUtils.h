@@ -1,4 +1,8 @@
 #pragma once
+#include "h5ppConstants.h"
+#include "h5ppPropertyLists.h"
+#include "h5ppTypeCompoundCreate.h"
+#include "h5ppTypeRegistry.h"
 #include "h5ppTypeSfinae.h"
 #include <cstring>
 #include <numeric>
@@ -7,7 +11,11 @@ namespace h5pp::utils {
 
     template<typename DataType>
     [[nodiscard]] hid::h5t getH5Type() {
-        namespace tc = h5pp::type::sfinae;
+        // Types are shared from the registry, except for text whose size is set on the returned copy
+        namespace tc  = h5pp::type::sfinae;
+        namespace tr  = h5pp::type::registry;
+        namespace tco = h5pp::type::compound;
+        namespace tcc = h5pp::type::compound::Create;
         /* clang-format off */
         using DecayType    = typename std::decay<DataType>::type;
         if constexpr (std::is_pointer_v<DecayType>)                                                     return getH5Type<typename std::remove_pointer<DecayType>::type>();
@@ -15,41 +23,41 @@ namespace h5pp::utils {
         if constexpr (std::is_array_v<DecayType>)                                                       return getH5Type<typename std::remove_all_extents<DecayType>::type>();
         if constexpr (tc::is_std_vector_v<DecayType>)                                                   return getH5Type<typename DecayType::value_type>();
 
-        if constexpr (std::is_same_v<DecayType, int>)                                                   return H5Tcopy(H5T_NATIVE_INT);
-        if constexpr (std::is_same_v<DecayType, long>)                                                  return H5Tcopy(H5T_NATIVE_LONG);
-        if constexpr (std::is_same_v<DecayType, long long>)                                             return H5Tcopy(H5T_NATIVE_LLONG);
-        if constexpr (std::is_same_v<DecayType, unsigned int>)                                          return H5Tcopy(H5T_NATIVE_UINT);
-        if constexpr (std::is_same_v<DecayType, unsigned long>)                                         return H5Tcopy(H5T_NATIVE_ULONG);
-        if constexpr (std::is_same_v<DecayType, unsigned long long >)                                   return H5Tcopy(H5T_NATIVE_ULLONG);
-        if constexpr (std::is_same_v<DecayType, double>)                                                return H5Tcopy(H5T_NATIVE_DOUBLE);
-        if constexpr (std::is_same_v<DecayType, float>)                                                 return H5Tcopy(H5T_NATIVE_FLOAT);
-        if constexpr (std::is_same_v<DecayType, bool>)                                                  return H5Tcopy(H5T_NATIVE_HBOOL);
+        if constexpr (std::is_same_v<DecayType, int>)                                                   return tr::getType<DecayType>(H5T_NATIVE_INT);
+        if constexpr (std::is_same_v<DecayType, long>)                                                  return tr::getType<DecayType>(H5T_NATIVE_LONG);
+        if constexpr (std::is_same_v<DecayType, long long>)                                             return tr::getType<DecayType>(H5T_NATIVE_LLONG);
+        if constexpr (std::is_same_v<DecayType, unsigned int>)                                          return tr::getType<DecayType>(H5T_NATIVE_UINT);
+        if constexpr (std::is_same_v<DecayType, unsigned long>)                                         return tr::getType<DecayType>(H5T_NATIVE_ULONG);
+        if constexpr (std::is_same_v<DecayType, unsigned long long >)                                   return tr::getType<DecayType>(H5T_NATIVE_ULLONG);
+        if constexpr (std::is_same_v<DecayType, double>)                                                return tr::getType<DecayType>(H5T_NATIVE_DOUBLE);
+        if constexpr (std::is_same_v<DecayType, float>)                                                 return tr::getType<DecayType>(H5T_NATIVE_FLOAT);
+        if constexpr (std::is_same_v<DecayType, bool>)                                                  return tr::getType<DecayType>(H5T_NATIVE_HBOOL);
         if constexpr (std::is_same_v<DecayType, std::string>)                                           return H5Tcopy(H5T_C_S1);
         if constexpr (std::is_same_v<DecayType, char>)                                                  return H5Tcopy(H5T_C_S1);
-        if constexpr (std::is_same_v<DecayType, std::complex<int>>)                                     return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_INT);
-        if constexpr (std::is_same_v<DecayType, std::complex<long>>)                                    return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_LONG);
-        if constexpr (std::is_same_v<DecayType, std::complex<long long>>)                               return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_LLONG);
-        if constexpr (std::is_same_v<DecayType, std::complex<unsigned int>>)                            return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_UINT);
-        if constexpr (std::is_same_v<DecayType, std::complex<unsigned long>>)                           return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_ULONG);
-        if constexpr (std::is_same_v<DecayType, std::complex<unsigned long long>>)                      return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_ULLONG);
-        if constexpr (std::is_same_v<DecayType, std::complex<double>>)                                  return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_DOUBLE);
-        if constexpr (std::is_same_v<DecayType, std::complex<float>>)                                   return H5Tcopy(h5pp::type::compound::H5T_COMPLEX_FLOAT);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, int>())                                         return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_INT);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, long>())                                        return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_LONG);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, long long>())                                   return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_LLONG);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, unsigned int>())                                return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_UINT);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, unsigned long>())                               return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_ULONG);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, unsigned long long>())                          return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_ULLONG);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, double>())                                      return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_DOUBLE);
-        if constexpr (tc::is_Scalar2_of_type<DecayType, float>())                                       return H5Tcopy(h5pp::type::compound::H5T_SCALAR2_FLOAT);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, int>())                                         return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_INT);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, long>())                                        return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_LONG);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, long long>())                                   return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_LLONG);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, unsigned int>())                                return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_UINT);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, unsigned long>())                               return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_ULONG);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, unsigned long long>())                          return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_ULLONG);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, double>())                                      return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_DOUBLE);
-        if constexpr (tc::is_Scalar3_of_type<DecayType, float>())                                       return H5Tcopy(h5pp::type::compound::H5T_SCALAR3_FLOAT);
+        if constexpr (std::is_same_v<DecayType, std::complex<int>>)                                     return tr::getType<DecayType>(tcc::createComplexType<int>);
+        if constexpr (std::is_same_v<DecayType, std::complex<long>>)                                    return tr::getType<DecayType>(tcc::createComplexType<long>);
+        if constexpr (std::is_same_v<DecayType, std::complex<long long>>)                               return tr::getType<DecayType>(tcc::createComplexType<long long>);
+        if constexpr (std::is_same_v<DecayType, std::complex<unsigned int>>)                            return tr::getType<DecayType>(tcc::createComplexType<unsigned int>);
+        if constexpr (std::is_same_v<DecayType, std::complex<unsigned long>>)                           return tr::getType<DecayType>(tcc::createComplexType<unsigned long>);
+        if constexpr (std::is_same_v<DecayType, std::complex<unsigned long long>>)                      return tr::getType<DecayType>(tcc::createComplexType<unsigned long long>);
+        if constexpr (std::is_same_v<DecayType, std::complex<double>>)                                  return tr::getType<DecayType>(tcc::createComplexType<double>);
+        if constexpr (std::is_same_v<DecayType, std::complex<float>>)                                   return tr::getType<DecayType>(tcc::createComplexType<float>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, int>())                                         return tr::getType<tco::H5T_SCALAR2<int>>(tcc::createScalar2Type<int>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, long>())                                        return tr::getType<tco::H5T_SCALAR2<long>>(tcc::createScalar2Type<long>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, long long>())                                   return tr::getType<tco::H5T_SCALAR2<long long>>(tcc::createScalar2Type<long long>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, unsigned int>())                                return tr::getType<tco::H5T_SCALAR2<unsigned int>>(tcc::createScalar2Type<unsigned int>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, unsigned long>())                               return tr::getType<tco::H5T_SCALAR2<unsigned long>>(tcc::createScalar2Type<unsigned long>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, unsigned long long>())                          return tr::getType<tco::H5T_SCALAR2<unsigned long long>>(tcc::createScalar2Type<unsigned long long>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, double>())                                      return tr::getType<tco::H5T_SCALAR2<double>>(tcc::createScalar2Type<double>);
+        if constexpr (tc::is_Scalar2_of_type<DecayType, float>())                                       return tr::getType<tco::H5T_SCALAR2<float>>(tcc::createScalar2Type<float>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, int>())                                         return tr::getType<tco::H5T_SCALAR3<int>>(tcc::createScalar3Type<int>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, long>())                                        return tr::getType<tco::H5T_SCALAR3<long>>(tcc::createScalar3Type<long>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, long long>())                                   return tr::getType<tco::H5T_SCALAR3<long long>>(tcc::createScalar3Type<long long>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, unsigned int>())                                return tr::getType<tco::H5T_SCALAR3<unsigned int>>(tcc::createScalar3Type<unsigned int>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, unsigned long>())                               return tr::getType<tco::H5T_SCALAR3<unsigned long>>(tcc::createScalar3Type<unsigned long>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, unsigned long long>())                          return tr::getType<tco::H5T_SCALAR3<unsigned long long>>(tcc::createScalar3Type<unsigned long long>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, double>())                                      return tr::getType<tco::H5T_SCALAR3<double>>(tcc::createScalar3Type<double>);
+        if constexpr (tc::is_Scalar3_of_type<DecayType, float>())                                       return tr::getType<tco::H5T_SCALAR3<float>>(tcc::createScalar3Type<float>);
         if constexpr (tc::has_Scalar_v <DecayType>)                                                     return getH5Type<typename DecayType::Scalar>();
         if constexpr (tc::has_value_type_v <DecayType>)                                                 return getH5Type<typename DataType::value_type>();
 
@@ -137,49 +145,60 @@ namespace h5pp::utils {
         }
     }
 
-    [[nodiscard]] inline std::vector<hsize_t>
-        getDefaultChunkDimensions(const size_t size, const std::vector<hsize_t> &dims, const std::optional<std::vector<hsize_t>> &desiredChunkDims = std::nullopt) {
+    [[nodiscard]] inline std::vector<hsize_t> getDefaultChunkDimensions(const std::vector<hsize_t> &               dims,
+                                                                        const size_t                               bytesPerElem,
+                                                                        const std::optional<std::vector<hsize_t>> &desiredChunkDims = std::nullopt,
+                                                                        const size_t                               targetBytes      = h5pp::constants::defaultChunkBytes) {
         // Chunk dimensions are always the same rank as the dataset dimensions.
-        // The simplest way to get a reasonable chunk dimension is to pick a slice, by setting one of
-        // the dimensions to 1.
-
-        // HDF5 is row-major, meaning that on a rank 3 tensor with indices i,j,k, we get contiguous slices
-        // when i is fixed (i.e. chunk dims: 1 x size(j) x size(k)). However since the i,j, and k dim
-        // sizes may be significantly different, we may have to reduce the chunk dimension even more.
-
-        // Here is a simple heuristic to find a chunk size:
-        // For a square matrix with N elements (N = n x n) reasonable chunk dimensions could be (1 x n),
-        // so that each row is a single chunk, and where n = sqrt(N) is the size of a single slice.
-        // When generalizing this to other dimensions, we can use sqrt(N) as an estimator of the slice size.
-
-        // For example, a rank 3 tensor with dimensions (100 x 20 x 5) has size N = 10000,
-        // with slice size = sqrt(N) = 100. To get reasonable chunk dimensions we reduce dataset
-        // dimensions by one starting from the left and stop right before becomming smaller than sqrt(N)
-        // In this case we get (1 x 20 x 5)
-
-        // A less trivial example is a tensor with dimensions (20 x 15 x 3 x 8), with N = 7200 and
-        // slice size sqrt(N) = 84.8528... The same procedure as before gives us chunk
-        // dimensions (1 x 4 x 3 x 8). Note that 1 x 4 x 3 x 8 = 96 which is just slightly bigger
-        // than 84.8528...
+        // We aim for chunks of about targetBytes, so that several chunks fit in the chunk cache, independently of the size of the elements.
+
+        // HDF5 is row-major, meaning that on a rank 3 tensor with indices i,j,k, the elements along k are contiguous,
+        // followed by those along j, and finally i. To read and write contiguous runs of elements, we fill the chunk
+        // starting from the fastest-varying (last) dimension, and move on to slower dimensions with whatever budget is left.
+
+        // For example, a matrix of doubles with dimensions (10000 x 10000) and a target of 256 KiB (32768 elements)
+        // gets chunk dimensions (3 x 10000), i.e. three full rows.
+        // A rank 3 tensor of doubles with dimensions (100 x 200 x 300) gets (1 x 109 x 300).
+        // Each dimension is visited once, so this is O(rank).
         if(desiredChunkDims.has_value()) {
             // Check that the desired rank matches dims
             if(dims.size() != desiredChunkDims.value().size()) throw std::runtime_error("Mismatch in rank: desired chunk dimensions and data dimensions");
             return desiredChunkDims.value();
         }
-        auto                 slice_size = static_cast<size_t>(std::ceil(std::sqrt(size)));
-        std::vector<hsize_t> chunkDims  = dims;
-        for(size_t dim = 0; dim < dims.size(); dim++) {
-            while(chunkDims[dim] > 1) {
-                size_t chunkSize = std::accumulate(chunkDims.begin(), chunkDims.end(), 1, std::multiplies<>());
-                if(chunkSize < slice_size)
-                    break;
-                else
-                    chunkDims[dim]--;
-            }
+        hsize_t              budget = std::max<hsize_t>(1, targetBytes / std::max<size_t>(1, bytesPerElem)); // In number of elements
+        std::vector<hsize_t> chunkDims(dims.size(), 1);
+        for(size_t idx = dims.size(); idx-- > 0;) {
+            chunkDims[idx] = std::max<hsize_t>(1, std::min(dims[idx], budget));
+            budget /= chunkDims[idx];
+            if(budget <= 1) break;
         }
         return chunkDims;
     }
 
+    [[nodiscard]] inline ChunkCache getDefaultChunkCache(const std::vector<hsize_t> &dims, const std::vector<hsize_t> &chunkDims, const size_t bytesPerElem) {
+        // Size the chunk cache so that it holds one layer of chunks across all but the slowest-varying dimension.
+        // Then reading or writing the dataset slice by slice along the first index touches (and decompresses) each chunk only once.
+        // For a rank 2 dataset this is one row of chunks, for rank 1 a single chunk suffices.
+        if(dims.size() != chunkDims.size()) throw std::runtime_error("Mismatch in rank: chunk dimensions and data dimensions");
+        hsize_t chunkBytes = bytesPerElem;
+        for(auto &chunkDim : chunkDims) chunkBytes *= std::max<hsize_t>(1, chunkDim);
+        hsize_t numChunks = 1;
+        for(size_t dim = 1; dim < dims.size(); dim++) numChunks *= (dims[dim] + std::max<hsize_t>(1, chunkDims[dim]) - 1) / std::max<hsize_t>(1, chunkDims[dim]);
+
+        ChunkCache cache;
+        cache.nbytes = std::max(chunkBytes, std::min<hsize_t>(h5pp::constants::maxSizeChunkCache, std::max<hsize_t>(h5pp::constants::minSizeChunkCache, numChunks * chunkBytes)));
+        // HDF5 recommends a prime number of slots, about 100 times the number of chunks that fit in the cache
+        size_t nslots = std::max<size_t>(cache.nslots, 100 * (cache.nbytes / std::max<hsize_t>(1, chunkBytes)));
+        auto   isPrime = [](size_t n) {
+            for(size_t div = 2; div * div <= n; div++)
+                if(n % div == 0) return false;
+            return true;
+        };
+        while(not isPrime(nslots)) nslots++;
+        cache.nslots = nslots;
+        return cache;
+    }
+
     [[nodiscard]] inline hid::h5s getDataSpace(const hsize_t size, const int ndims, const std::vector<hsize_t> &dims, const H5D_layout_t layout) {
         assert((size_t) ndims == dims.size() and "Dimension mismatch");
         if(size == 0) return H5Screate(H5S_NULL);
@@ -252,6 +271,12 @@ namespace h5pp::utils {
 
     [[nodiscard]] inline size_t getBytesTotal(const hid::h5s &space, const hid::h5t &type) { return H5Sget_simple_extent_npoints(space) * H5Tget_size(type); }
 
+    /*! The bytes transferred by a read or write with the selection of the given space, before any compression */
+    [[nodiscard]] inline size_t getBytesSelected(const hid::h5s &space, const hid::h5t &type) {
+        hssize_t npoints = H5Sget_select_npoints(space);
+        return npoints > 0 ? static_cast<size_t>(npoints) * H5Tget_size(type) : 0;
+    }
+
     [[nodiscard]] inline size_t getBytesTotal(const hid::h5d &dataset) {
         hid::h5s space = H5Dget_space(dataset);
         hid::h5t type  = H5Dget_type(dataset);
@@ -262,7 +287,7 @@ namespace h5pp::utils {
     [[nodiscard]] bool checkBytesPerElemMatch(const hid::h5t &hdf5Datatype) {
         size_t dsetTypeSize = getBytesPerElem(hdf5Datatype);
         size_t dataTypeSize = getBytesPerElem<userDataType>();
-        if(dataTypeSize != dsetTypeSize) { h5pp::logger::log->debug("Type size mismatch: dataset type {} bytes | given type {} bytes", dsetTypeSize, dataTypeSize); }
+        if(dataTypeSize != dsetTypeSize) { H5PP_DEBUG("Type size mismatch: dataset type {} bytes | given type {} bytes", dsetTypeSize, dataTypeSize); }
         return dataTypeSize == dsetTypeSize;
     }
 
@@ -292,6 +317,16 @@ namespace h5pp::utils {
         }
     }
 
+    template<typename DataType, typename = std::enable_if_t<not std::is_base_of_v<hid::hid_base<DataType>, DataType>>>
+    void assertBytesMatchSelection(const DataType &data, const hid::h5s &space, const hid::h5t &type) {
+        // Same as assertBytesMatchTotal, but only counts the elements selected in the dataspace, e.g. by a hyperslab
+        size_t dsetsize = H5Sget_select_npoints(space) * H5Tget_size(type);
+        size_t datasize = getBytesTotal(data);
+        if(datasize != dsetsize) {
+            throw std::runtime_error("Storage size mismatch: selection " + std::to_string(dsetsize) + " bytes | given " + std::to_string(datasize) + " bytes");
+        }
+    }
+
     template<typename DataType, typename = std::enable_if_t<not std::is_base_of_v<hid::hid_base<DataType>, DataType>>>
     inline hsize_t setStringSize(const DataType &data, const hid::h5t &datatype) {
         hsize_t size = h5pp::utils::getSize(data);
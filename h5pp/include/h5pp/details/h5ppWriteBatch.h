@@ -0,0 +1,148 @@
+#pragma once
+#include "h5ppFile.h"
+#include "h5ppHid.h"
+#include "h5ppLinkCache.h"
+#include "h5ppTypeSfinae.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace h5pp {
+
+    /*!
+     \brief Collects writes of many small datasets and attributes, e.g. the metadata of a checkpoint, and writes them together.
+
+     Obtain one with h5pp::File::beginBatch(). The data is copied when added, so it may change or go out of scope before the commit.
+     commit() opens the file once, creates each parent group once, and reuses one dataset creation property list per layout
+     for new compact and contiguous datasets. Items are written in the order they were added.
+     An item that fails does not stop the others: its error is returned by commit() instead.
+    */
+    class WriteBatch {
+        public:
+        struct Error {
+            size_t      index;    /*!< Position of the item in the batch */
+            std::string linkName; /*!< The dataset, or the link that holds the attribute */
+            std::string attrName; /*!< Empty for datasets */
+            std::string message;
+        };
+
+        private:
+        /*! What the items of one commit learn about the file, shared between them */
+        struct Context {
+            LinkCache                          links;
+            std::map<H5D_layout_t, hid::h5p> dsetCreatePlists; /*!< One creation property list per layout, for compact and contiguous datasets */
+        };
+
+        struct Item {
+            std::string                                          linkName;
+            std::string                                          attrName;
+            std::function<void(File &, hid::h5f &, Context &)> write;
+        };
+
+        File *            file;
+        std::vector<Item> items;
+
+        // Text given as a char pointer is stored as a string. Other pointers can't be stored, since the data they point to may change before the commit
+        template<typename DataType>
+        using StoredType = std::conditional_t<std::is_same_v<std::decay_t<DataType>, const char *> or std::is_same_v<std::decay_t<DataType>, char *>,
+                                              std::string,
+                                              std::decay_t<DataType>>;
+
+        template<typename DataType>
+        static void assertOwning() {
+            using Stored = StoredType<DataType>;
+            static_assert(not std::is_pointer_v<Stored> and not h5pp::type::sfinae::is_ptr_wrapper_v<Stored>,
+                          "Batched writes need to own their data: pointers can't be batched");
+#ifdef H5PP_EIGEN3
+            static_assert(not h5pp::type::sfinae::is_eigen_any<Stored>::value or h5pp::type::sfinae::has_resize_v<Stored>,
+                          "Batched writes need to own their data: Eigen maps can't be batched");
+#endif
+        }
+
+        static void createParentGroup(File &file, hid::h5f &handle, Context &context, std::string_view linkName) {
+            auto pos = linkName.find_last_of('/');
+            if(pos == std::string_view::npos or pos == 0) return; // Lives in the root group
+            auto parent = linkName.substr(0, pos);
+            if(context.links.linkExists(parent) or file.cachedLinkExists(parent)) return;
+            h5pp::hdf5::createGroup(handle, parent, std::nullopt, file.plists);
+            context.links.insert(parent, H5O_TYPE_GROUP);
+            file.cacheLink(parent, H5O_TYPE_GROUP);
+        }
+
+        public:
+        explicit WriteBatch(File &file_) : file(&file_) {}
+
+        template<typename DataType>
+        void writeDataset(DataType &&                         data,
+                          std::string_view                    dsetName,
+                          std::optional<H5D_layout_t>         layout           = std::nullopt,
+                          std::optional<std::vector<hsize_t>> chunkDimensions  = std::nullopt,
+                          std::optional<unsigned int>         compressionLevel = std::nullopt,
+                          std::optional<std::vector<Filter>>  filters          = std::nullopt) {
+            assertOwning<DataType>();
+            auto stored = std::make_shared<const StoredType<DataType>>(std::forward<DataType>(data));
+            items.push_back({std::string(dsetName),
+                             "",
+                             [stored, name = std::string(dsetName), layout, chunkDimensions, compressionLevel, filters](File &file, hid::h5f &handle, Context &context) {
+                                 createParentGroup(file, handle, context, name);
+                                 // With the parent group in place, only the dataset itself needs looking up
+                                 std::optional<bool> dsetExists = context.links.linkExists(name);
+                                 if(not dsetExists) dsetExists = file.cachedLinkExists(name);
+                                 if(not dsetExists) {
+                                     htri_t exists = H5Lexists(handle, name.c_str(), file.plists.link_access);
+                                     if(exists < 0) throw std::runtime_error("Failed to check if link exists: [" + name + "]");
+                                     dsetExists = exists > 0;
+                                 }
+                                 auto expectedLayout = h5pp::utils::decideLayout(h5pp::utils::getBytesTotal(*stored), layout);
+                                 std::optional<hid::h5p> dsetCreatePlist;
+                                 if(auto it = context.dsetCreatePlists.find(expectedLayout); it != context.dsetCreatePlists.end()) dsetCreatePlist = it->second;
+                                 auto dsetProps = file.writeDatasetToHandle(handle, *stored, name, dsetExists, layout, chunkDimensions, compressionLevel, filters, dsetCreatePlist);
+                                 context.links.insert(name, H5O_TYPE_DATASET);
+                                 if(dsetProps.layout.value() != H5D_CHUNKED and dsetProps.plist_dset_create.valid())
+                                     context.dsetCreatePlists.emplace(dsetProps.layout.value(), dsetProps.plist_dset_create);
+                             }});
+        }
+
+        template<typename DataType>
+        void writeAttribute(DataType &&data, std::string_view attrName, std::string_view linkName) {
+            assertOwning<DataType>();
+            auto stored = std::make_shared<const StoredType<DataType>>(std::forward<DataType>(data));
+            items.push_back({std::string(linkName),
+                             std::string(attrName),
+                             [stored, attrName = std::string(attrName), linkName = std::string(linkName)](File &file, hid::h5f &handle, Context &context) {
+                                 std::optional<bool> linkExists = context.links.linkExists(linkName);
+                                 if(not linkExists) linkExists = file.cachedLinkExists(linkName);
+                                 file.writeAttributeToHandle(handle, *stored, attrName, linkName, linkExists);
+                                 context.links.insert(linkName, H5O_TYPE_UNKNOWN);
+                             }});
+        }
+
+        /*! Write all items, and empty the batch. Returns the errors of the items that failed, if any */
+        [[nodiscard]] std::vector<Error> commit() {
+            std::vector<Error> errors;
+            if(items.empty()) return errors;
+            if(file->getAccessMode() == AccessMode::READONLY) throw std::runtime_error("Attempted to write to read-only file");
+            auto     lock   = file->lockCall();
+            auto     scope  = file->statsScope();
+            hid::h5f handle = file->openFileHandle();
+            H5PP_DEBUG("Writing batch of {} items", items.size());
+            Context context;
+            for(size_t idx = 0; idx < items.size(); idx++) {
+                try {
+                    items[idx].write(*file, handle, context);
+                } catch(const std::exception &ex) { errors.push_back({idx, items[idx].linkName, items[idx].attrName, ex.what()}); }
+            }
+            items.clear();
+            return errors;
+        }
+
+        [[nodiscard]] size_t size() const { return items.size(); }
+        [[nodiscard]] bool   empty() const { return items.empty(); }
+        void                 clear() { items.clear(); }
+    };
+}
+
+inline h5pp::WriteBatch h5pp::File::beginBatch() { return WriteBatch(*this); }
@@ -1,2 +1,3 @@
 #pragma once
 #include "details/h5ppFile.h"
+#include "details/h5ppWriteBatch.h"
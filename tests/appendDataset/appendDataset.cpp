@@ -0,0 +1,46 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/appendDataset.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // The first append creates an extendable dataset, the following ones grow it
+    for(int step = 0; step < 10; step++) {
+        std::vector<double> vectorDouble(5, step);
+        file.appendToDataset(vectorDouble, "appendGroup/vectorDouble");
+    }
+    auto vectorRead = file.readDataset<std::vector<double>>("appendGroup/vectorDouble");
+    if(vectorRead.size() != 50) throw std::runtime_error("Append failed: wrong size " + std::to_string(vectorRead.size()));
+    for(size_t i = 0; i < vectorRead.size(); i++)
+        if(vectorRead[i] != (double) (i / 5)) throw std::runtime_error("Append failed: wrong value at " + std::to_string(i));
+
+    // Appending with a different type or to a non-chunked dataset should fail
+    try {
+        file.appendToDataset(std::vector<int>(5, 1), "appendGroup/vectorDouble");
+        throw std::logic_error("Appending a different type should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+    file.writeDataset(std::vector<double>(5, 0.0), "appendGroup/vectorContiguous", H5D_CONTIGUOUS);
+    try {
+        file.appendToDataset(std::vector<double>(5, 1.0), "appendGroup/vectorContiguous");
+        throw std::logic_error("Appending to a contiguous dataset should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+
+#ifdef H5PP_EIGEN3
+    // Append columns, i.e. along axis 1
+    Eigen::MatrixXd matrixDouble = Eigen::MatrixXd::Random(4, 3);
+    file.appendToDataset(matrixDouble, "appendGroup/matrixDouble");
+    Eigen::MatrixXd matrixCols = Eigen::MatrixXd::Random(4, 2);
+    file.appendToDataset(matrixCols, "appendGroup/matrixDouble", 1);
+    auto matrixRead = file.readDataset<Eigen::MatrixXd>("appendGroup/matrixDouble");
+    if(matrixRead.rows() != 4 or matrixRead.cols() != 5) throw std::runtime_error("Append failed: wrong matrix dimensions");
+    if(matrixRead.leftCols(3) != matrixDouble) throw std::runtime_error("Append failed: original columns changed");
+    if(matrixRead.rightCols(2) != matrixCols) throw std::runtime_error("Append failed: appended columns differ");
+    try {
+        file.appendToDataset(Eigen::MatrixXd(3, 2), "appendGroup/matrixDouble", 1);
+        throw std::logic_error("Appending with mismatching rows should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+#endif
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/asyncWrite.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Copies of lvalues are written, so the data can be changed as soon as the call returns
+    std::vector<double>            data(1000, 1.0);
+    std::vector<std::future<void>> futures;
+    for(int i = 0; i < 20; i++) {
+        std::fill(data.begin(), data.end(), static_cast<double>(i));
+        futures.push_back(file.writeDatasetAsync(data, "asyncGroup/dset_" + std::to_string(i)));
+    }
+    for(auto &future : futures) future.get();
+    for(int i = 0; i < 20; i++) {
+        auto readData = file.readDataset<std::vector<double>>("asyncGroup/dset_" + std::to_string(i));
+        if(readData != std::vector<double>(1000, static_cast<double>(i))) throw std::runtime_error("Mismatch in dataset " + std::to_string(i));
+    }
+
+    // Rvalues are moved instead of copied
+    std::vector<int> moved(500, 7);
+    auto             movedFuture = file.writeDatasetAsync(std::move(moved), "asyncGroup/moved");
+    movedFuture.get();
+
+    // Other calls on the file wait for pending writes
+    [[maybe_unused]] auto pending = file.writeDatasetAsync(std::vector<double>(100, 3.0), "asyncGroup/implicit");
+    if(file.readDataset<std::vector<double>>("asyncGroup/implicit") != std::vector<double>(100, 3.0)) throw std::runtime_error("Read before the write was done");
+    if(file.readDataset<std::vector<int>>("asyncGroup/moved") != std::vector<int>(500, 7)) throw std::runtime_error("Mismatch in moved dataset");
+
+    // Errors are delivered through the future
+    file.writeDataset(std::vector<double>(10, 1.0), "asyncGroup/fixed", H5D_CONTIGUOUS);
+    auto failing = file.writeDatasetAsync(std::vector<double>(20, 1.0), "asyncGroup/fixed");
+    try {
+        failing.get();
+        throw std::logic_error("Resizing a contiguous dataset should have failed");
+    } catch(const std::runtime_error &err) { std::cout << "Caught expected error: " << err.what() << std::endl; }
+
+    // With a queue depth of one, producers block until there is room, and all writes still arrive in order
+    file.setAsyncQueueDepth(1);
+    if(file.getAsyncQueueDepth() != 1) throw std::runtime_error("Failed to set the queue depth");
+    for(int i = 0; i < 50; i++) [[maybe_unused]] auto future = file.writeDatasetAsync(static_cast<double>(i), "asyncGroup/overwrite");
+    file.waitAsync();
+    if(file.readDataset<double>("asyncGroup/overwrite") != 49.0) throw std::runtime_error("Writes were not done in order");
+
+#ifdef H5PP_EIGEN3
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(10, 5);
+    file.writeDatasetAsync(matrix, "asyncGroup/matrix").get();
+    if(not file.readDataset<Eigen::MatrixXd>("asyncGroup/matrix").isApprox(matrix)) throw std::runtime_error("Mismatch in Eigen matrix");
+#endif
+
+    // The destructor finishes pending writes
+    {
+        h5pp::File other(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::OPEN, logLevel);
+        [[maybe_unused]] auto future = other.writeDatasetAsync(std::vector<double>(10, 5.0), "asyncGroup/destructor");
+    }
+    if(file.readDataset<std::vector<double>>("asyncGroup/destructor") != std::vector<double>(10, 5.0)) throw std::runtime_error("Pending write was lost");
+
+    h5pp::File readOnly(outputFilename, h5pp::AccessMode::READONLY, h5pp::CreateMode::OPEN, logLevel);
+    try {
+        [[maybe_unused]] auto future = readOnly.writeDatasetAsync(1.0, "asyncGroup/readOnly");
+        throw std::logic_error("Writing to a read-only file should have failed");
+    } catch(const std::runtime_error &err) { std::cout << "Caught expected error: " << err.what() << std::endl; }
+    return 0;
+}
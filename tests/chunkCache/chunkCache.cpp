@@ -0,0 +1,79 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+h5pp::ChunkCache getChunkCache(const h5pp::Dataset &dset) {
+    h5pp::hid::h5p   dapl = H5Dget_access_plist(dset.getProperties().dataSet);
+    h5pp::ChunkCache cache;
+    if(H5Pget_chunk_cache(dapl, &cache.nslots, &cache.nbytes, &cache.w0) < 0) throw std::runtime_error("Failed to get chunk cache");
+    return cache;
+}
+
+int main() {
+    std::string outputFilename = "output/chunkCache.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    std::vector<double> vectorDouble(10000);
+    std::iota(vectorDouble.begin(), vectorDouble.end(), 0.0);
+    file.writeDataset(vectorDouble, "chunkCacheGroup/vectorDouble", H5D_CHUNKED, std::vector<hsize_t>{1000});
+    file.writeDataset(vectorDouble, "chunkCacheGroup/vectorOther", H5D_CHUNKED, std::vector<hsize_t>{1000});
+
+    // A file-wide default
+    h5pp::ChunkCache fileCache{4 * 1024 * 1024, 1009, 0.5};
+    file.setChunkCache(fileCache);
+    auto fileCacheRead = getChunkCache(file.openDataset("chunkCacheGroup/vectorOther"));
+    if(fileCacheRead.nbytes != fileCache.nbytes or fileCacheRead.nslots != fileCache.nslots or fileCacheRead.w0 != fileCache.w0)
+        throw std::runtime_error("File-wide chunk cache was not applied");
+
+    // Per dataset, overriding the file-wide default
+    h5pp::ChunkCache dsetCache{8 * 1024 * 1024, 2003, 1.0};
+    file.setChunkCache(dsetCache, "chunkCacheGroup/vectorDouble");
+    auto dsetCacheRead = getChunkCache(file.openDataset("chunkCacheGroup/vectorDouble"));
+    if(dsetCacheRead.nbytes != dsetCache.nbytes or dsetCacheRead.nslots != dsetCache.nslots) throw std::runtime_error("Dataset chunk cache was not applied");
+    if(getChunkCache(file.openDataset("chunkCacheGroup/vectorOther")).nbytes != fileCache.nbytes) throw std::runtime_error("Dataset chunk cache leaked to other datasets");
+    if(file.readDataset<std::vector<double>>("chunkCacheGroup/vectorDouble") != vectorDouble) throw std::runtime_error("Failed to read with dataset chunk cache");
+    // Datasets are matched by path, however it is written, and file-wide settings made later still apply to them
+    if(getChunkCache(file.openDataset("/chunkCacheGroup//vectorDouble")).nbytes != dsetCache.nbytes) throw std::runtime_error("Dataset chunk cache was not matched by path");
+    file.setReadThreads(3);
+    if(file.getPropertyLists("chunkCacheGroup/vectorDouble").readThreads != 3) throw std::runtime_error("File-wide setting did not apply to dataset with chunk cache");
+    file.setReadThreads(1);
+    {
+        // Copies keep the settings of the original
+        file.setDefaultChunkBytes(128 * 1024);
+        file.setAsyncQueueDepth(7);
+        file.setReadThreads(2);
+        h5pp::File copy = file;
+        if(copy.getDefaultChunkBytes() != 128 * 1024 or copy.getAsyncQueueDepth() != 7 or copy.getReadThreads() != 2)
+            throw std::runtime_error("Copy lost the settings of the file");
+        if(getChunkCache(copy.openDataset("chunkCacheGroup/vectorDouble")).nbytes != dsetCache.nbytes) throw std::runtime_error("Copy lost the dataset chunk cache");
+        file.setDefaultChunkBytes(h5pp::constants::defaultChunkBytes);
+        file.setReadThreads(1);
+    }
+
+    // On a dataset handle only
+    h5pp::ChunkCache handleCache{2 * 1024 * 1024, 101, 0.25};
+    auto             dset = file.openDataset("chunkCacheGroup/vectorOther", handleCache);
+    if(getChunkCache(dset).nbytes != handleCache.nbytes) throw std::runtime_error("Handle chunk cache was not applied");
+    if(dset.read<std::vector<double>>() != vectorDouble) throw std::runtime_error("Failed to read through handle with chunk cache");
+
+    // Sized from the chunk dimensions: a row of 20 chunks of 100 x 100 doubles should fit
+    auto autoCache = h5pp::utils::getDefaultChunkCache({1000, 2000}, {100, 100}, sizeof(double));
+    if(autoCache.nbytes != 20 * 100 * 100 * sizeof(double)) throw std::runtime_error("Wrong size of automatic chunk cache: " + std::to_string(autoCache.nbytes));
+    if(autoCache.nslots < 2000) throw std::runtime_error("Too few slots in automatic chunk cache: " + std::to_string(autoCache.nslots));
+    // Automatic chunk dimensions target a size in bytes, independently of the element type
+    if(h5pp::utils::getDefaultChunkDimensions({10000, 10000}, sizeof(double), std::nullopt, 256 * 1024) != std::vector<hsize_t>{3, 10000})
+        throw std::runtime_error("Wrong chunk dimensions for matrix");
+    if(h5pp::utils::getDefaultChunkDimensions({100, 200, 300}, sizeof(double), std::nullopt, 256 * 1024) != std::vector<hsize_t>{1, 109, 300})
+        throw std::runtime_error("Wrong chunk dimensions for tensor");
+    auto chunkComplex = h5pp::utils::getDefaultChunkDimensions({1000000}, sizeof(std::complex<double>));
+    auto chunkChar    = h5pp::utils::getDefaultChunkDimensions({1000000}, sizeof(char));
+    if(chunkComplex[0] * sizeof(std::complex<double>) != chunkChar[0] * sizeof(char)) throw std::runtime_error("Chunk sizes in bytes differ between element types");
+    file.setDefaultChunkBytes(64 * 1024);
+    file.writeDataset(std::vector<std::complex<double>>(100000), "chunkCacheGroup/vectorComplex", H5D_CHUNKED);
+    auto chunkDimsComplex = file.openDataset("chunkCacheGroup/vectorComplex").getProperties().chunkDims.value();
+    if(chunkDimsComplex[0] * sizeof(std::complex<double>) != 64 * 1024) throw std::runtime_error("Default chunk size was not applied: " + std::to_string(chunkDimsComplex[0]));
+
+    file.setChunkCache("chunkCacheGroup/vectorOther");
+    if(file.readDataset<std::vector<double>>("chunkCacheGroup/vectorOther") != vectorDouble) throw std::runtime_error("Failed to read with automatic chunk cache");
+    return 0;
+}
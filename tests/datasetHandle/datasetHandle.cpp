@@ -0,0 +1,64 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/datasetHandle.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Create the datasets as usual first
+    std::vector<double> vectorDouble(100, 0.0);
+    file.writeDataset(vectorDouble, "datasetHandleGroup/vectorDouble");
+    file.writeDataset(vectorDouble, "datasetHandleGroup/vectorDoubleChunked", H5D_CHUNKED);
+    file.writeDataset(std::string("short string"), "datasetHandleGroup/string");
+
+    // Overwrite repeatedly through a handle
+    auto dset = file.openDataset("datasetHandleGroup/vectorDouble");
+    if(dset.getDimensions() != std::vector<hsize_t>{100}) throw std::runtime_error("Wrong dimensions on dataset handle");
+    for(int step = 0; step < 100; step++) {
+        std::fill(vectorDouble.begin(), vectorDouble.end(), step);
+        dset.write(vectorDouble);
+    }
+    if(dset.read<std::vector<double>>() != vectorDouble) throw std::runtime_error("vectorDouble != vectorDoubleRead");
+    if(file.readDataset<std::vector<double>>("datasetHandleGroup/vectorDouble") != vectorDouble) throw std::runtime_error("vectorDouble != vectorDoubleRead from file");
+
+    // Writing with a different type or a different size on a non-chunked dataset should fail
+    try {
+        dset.write(std::vector<int>(100, 1));
+        throw std::logic_error("Writing a different type should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+    try {
+        dset.write(std::vector<double>(200, 1.0));
+        throw std::logic_error("Resizing a non-chunked dataset should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+
+    // Chunked datasets can be resized and appended to
+    auto dsetChunked = file.openDataset("datasetHandleGroup/vectorDoubleChunked");
+    std::vector<double> vectorLonger(150);
+    std::iota(vectorLonger.begin(), vectorLonger.end(), 0.0);
+    dsetChunked.write(vectorLonger);
+    if(dsetChunked.getSize() != 150) throw std::runtime_error("Dataset handle was not resized");
+    std::vector<double> vectorTail(50, 42.0);
+    dsetChunked.append(vectorTail);
+    auto vectorAppendedRead = file.readDataset<std::vector<double>>("datasetHandleGroup/vectorDoubleChunked");
+    if(vectorAppendedRead.size() != 200) throw std::runtime_error("Append failed: wrong size " + std::to_string(vectorAppendedRead.size()));
+    for(size_t i = 0; i < 200; i++)
+        if(vectorAppendedRead[i] != (i < 150 ? (double) i : 42.0)) throw std::runtime_error("Append failed: wrong value at " + std::to_string(i));
+
+    auto dsetString = file.openDataset("datasetHandleGroup/string");
+    dsetString.write(std::string("short string"));
+    if(dsetString.read<std::string>() != "short string") throw std::runtime_error("Failed to read string through handle");
+
+#ifdef H5PP_EIGEN3
+    Eigen::MatrixXd matrixDouble = Eigen::MatrixXd::Random(4, 3);
+    file.writeDataset(matrixDouble, "datasetHandleGroup/matrixDouble", H5D_CHUNKED);
+    auto            dsetMatrix = file.openDataset("datasetHandleGroup/matrixDouble");
+    Eigen::MatrixXd matrixRows = Eigen::MatrixXd::Random(2, 3);
+    dsetMatrix.append(matrixRows);
+    auto matrixRead = dsetMatrix.read<Eigen::MatrixXd>();
+    if(matrixRead.rows() != 6 or matrixRead.cols() != 3) throw std::runtime_error("Append failed: wrong matrix dimensions");
+    if(matrixRead.topRows(4) != matrixDouble) throw std::runtime_error("Append failed: original rows changed");
+    if(matrixRead.bottomRows(2) != matrixRows) throw std::runtime_error("Append failed: appended rows differ");
+#endif
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/eigenLayout.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Column-major objects larger than h5pp::constants::maxSizeTransposeTile are transposed tile by tile
+    Eigen::MatrixXd matrixDouble = Eigen::MatrixXd::Random(1500, 1000);
+    file.writeDataset(matrixDouble, "eigenLayoutGroup/matrixDouble");
+    auto matrixRowmajor = file.readDataset<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>("eigenLayoutGroup/matrixDouble");
+    if(matrixRowmajor != matrixDouble) throw std::runtime_error("Tiled write of column-major matrix failed");
+
+    // Tall matrices, where a single column exceeds a tile
+    Eigen::ArrayXXf arrayFloat = Eigen::ArrayXXf::Random(3000000, 2);
+    file.writeDataset(arrayFloat, "eigenLayoutGroup/arrayFloat", H5D_CHUNKED);
+    auto arrayRowmajor = file.readDataset<Eigen::Array<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>("eigenLayoutGroup/arrayFloat");
+    if((arrayRowmajor != arrayFloat).any()) throw std::runtime_error("Tiled write of tall column-major array failed");
+
+    // Wide matrices, where a single row exceeds a tile
+    Eigen::MatrixXd matrixWide = Eigen::MatrixXd::Random(3, 1500000);
+    file.writeDataset(matrixWide, "eigenLayoutGroup/matrixWide");
+    auto matrixWideRowmajor = file.readDataset<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>("eigenLayoutGroup/matrixWide");
+    if(matrixWideRowmajor != matrixWide) throw std::runtime_error("Tiled write of wide column-major matrix failed");
+
+    // Into a sub-region of a larger dataset
+    file.writeDataset(Eigen::MatrixXd::Zero(1600, 1100).eval(), "eigenLayoutGroup/matrixLarger");
+    file.writeDataset(matrixDouble, "eigenLayoutGroup/matrixLarger", {50, 60});
+    auto matrixLarger = file.readDataset<Eigen::MatrixXd>("eigenLayoutGroup/matrixLarger");
+    if(matrixLarger.block(50, 60, 1500, 1000) != matrixDouble) throw std::runtime_error("Tiled write into sub-region failed");
+    if(matrixLarger(0, 0) != 0.0 or matrixLarger(1599, 1099) != 0.0) throw std::runtime_error("Tiled write changed values outside the sub-region");
+
+    // Tensors are written in slabs along the last index
+    Eigen::Tensor<double, 3> tensorDouble(100, 120, 150);
+    tensorDouble.setRandom();
+    file.writeDataset(tensorDouble, "eigenLayoutGroup/tensorDouble");
+    auto tensorRowmajor = file.readDataset<Eigen::Tensor<double, 3, Eigen::RowMajor>>("eigenLayoutGroup/tensorDouble");
+    for(long i = 0; i < tensorDouble.dimension(0); i++)
+        for(long j = 0; j < tensorDouble.dimension(1); j++)
+            for(long k = 0; k < tensorDouble.dimension(2); k++)
+                if(tensorRowmajor(i, j, k) != tensorDouble(i, j, k)) throw std::runtime_error("Tiled write of column-major tensor failed");
+
+    // Reading large column-major objects is likewise done tile by tile
+    auto matrixColmajor = file.readDataset<Eigen::MatrixXd>("eigenLayoutGroup/matrixDouble");
+    if(matrixColmajor != matrixDouble) throw std::runtime_error("Tiled read of column-major matrix failed");
+    auto arrayColmajor = file.readDataset<Eigen::ArrayXXf>("eigenLayoutGroup/arrayFloat");
+    if((arrayColmajor != arrayFloat).any()) throw std::runtime_error("Tiled read of tall column-major array failed");
+    auto matrixWideColmajor = file.readDataset<Eigen::MatrixXd>("eigenLayoutGroup/matrixWide");
+    if(matrixWideColmajor != matrixWide) throw std::runtime_error("Tiled read of wide column-major matrix failed");
+    auto matrixRegion = file.readDataset<Eigen::MatrixXd>("eigenLayoutGroup/matrixLarger", {50, 60}, {1500, 1000});
+    if(matrixRegion != matrixDouble) throw std::runtime_error("Tiled read of sub-region failed");
+    auto tensorColmajor = file.readDataset<Eigen::Tensor<double, 3>>("eigenLayoutGroup/tensorDouble");
+    for(long i = 0; i < tensorDouble.dimension(0); i++)
+        for(long j = 0; j < tensorDouble.dimension(1); j++)
+            for(long k = 0; k < tensorDouble.dimension(2); k++)
+                if(tensorColmajor(i, j, k) != tensorDouble(i, j, k)) throw std::runtime_error("Tiled read of column-major tensor failed");
+
+    // Whether to read in tiles depends on the size in memory, not the compressed size on file
+    Eigen::MatrixXd matrixZero = Eigen::MatrixXd::Zero(1500, 1000);
+    file.writeDataset(matrixZero, "eigenLayoutGroup/matrixZero", H5D_CHUNKED, std::nullopt, 6);
+    file.setCollectStats();
+    if(file.readDataset<Eigen::MatrixXd>("eigenLayoutGroup/matrixZero") != matrixZero) throw std::runtime_error("Read of compressed column-major matrix failed");
+    if(file.getStats().datasetReads.count < 2) throw std::runtime_error("Compressed column-major matrix was not read in tiles");
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+bool hasFilter(const std::vector<h5pp::Filter> &filters, H5Z_filter_t id) {
+    return std::any_of(filters.begin(), filters.end(), [id](const h5pp::Filter &filter) { return filter.id == id; });
+}
+
+int main() {
+    std::string outputFilename = "output/filters.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Smooth data compresses well
+    std::vector<double> vectorDouble(100000);
+    for(size_t i = 0; i < vectorDouble.size(); i++) vectorDouble[i] = std::sin(0.001 * i);
+    file.writeDataset(vectorDouble, "filterGroup/uncompressed", H5D_CHUNKED);
+    auto bytesUncompressed = file.openDataset("filterGroup/uncompressed").getProperties().bytes.value();
+
+    if(h5pp::hdf5::checkIfCompressionIsAvailable()) {
+        // A plain compression level should enable deflate
+        file.writeDataset(vectorDouble, "filterGroup/deflate", H5D_CHUNKED, std::nullopt, 6);
+        auto dsetDeflate = file.openDataset("filterGroup/deflate");
+        if(not hasFilter(dsetDeflate.getFilters(), H5Z_FILTER_DEFLATE)) throw std::runtime_error("Compression level did not enable deflate");
+        if(dsetDeflate.getProperties().bytes.value() >= bytesUncompressed) throw std::runtime_error("Deflate did not compress");
+        if(dsetDeflate.read<std::vector<double>>() != vectorDouble) throw std::runtime_error("Deflate round trip failed");
+
+        // Shuffle + deflate + checksum
+        std::vector<h5pp::Filter> pipeline = {h5pp::filter::shuffle(), h5pp::filter::deflate(6), h5pp::filter::fletcher32()};
+        file.writeDataset(vectorDouble, "filterGroup/shuffleDeflate", H5D_CHUNKED, std::nullopt, std::nullopt, pipeline);
+        auto dsetShuffle = file.openDataset("filterGroup/shuffleDeflate");
+        auto filters     = dsetShuffle.getFilters();
+        if(filters.size() != 3 or filters[0].id != H5Z_FILTER_SHUFFLE or filters[1].id != H5Z_FILTER_DEFLATE or filters[2].id != H5Z_FILTER_FLETCHER32)
+            throw std::runtime_error("Wrong filter pipeline on file");
+        if(dsetShuffle.getProperties().bytes.value() >= bytesUncompressed) throw std::runtime_error("Shuffle + deflate did not compress");
+        if(dsetShuffle.read<std::vector<double>>() != vectorDouble) throw std::runtime_error("Shuffle + deflate round trip failed");
+
+        // A compression level together with filters adds deflate after them, unless they include it already
+        file.writeDataset(vectorDouble, "filterGroup/shuffleLevel", H5D_CHUNKED, std::nullopt, 4, std::vector<h5pp::Filter>{h5pp::filter::shuffle()});
+        auto filtersLevel = file.openDataset("filterGroup/shuffleLevel").getFilters();
+        if(filtersLevel.size() != 2 or filtersLevel[0].id != H5Z_FILTER_SHUFFLE or filtersLevel[1].id != H5Z_FILTER_DEFLATE)
+            throw std::runtime_error("Deflate was not added after the given filters");
+        file.writeDataset(vectorDouble, "filterGroup/deflateLevel", H5D_CHUNKED, std::nullopt, 4, pipeline);
+        if(file.openDataset("filterGroup/deflateLevel").getFilters().size() != 3) throw std::runtime_error("Deflate was added twice");
+    }
+
+    // Scale-offset keeping 3 decimals is lossy
+    file.writeDataset(vectorDouble, "filterGroup/scaleOffset", H5D_CHUNKED, std::nullopt, std::nullopt, std::vector<h5pp::Filter>{h5pp::filter::scaleOffset(H5Z_SO_FLOAT_DSCALE, 3)});
+    auto vectorScaleOffset = file.readDataset<std::vector<double>>("filterGroup/scaleOffset");
+    for(size_t i = 0; i < vectorDouble.size(); i++)
+        if(std::abs(vectorScaleOffset[i] - vectorDouble[i]) > 1e-3) throw std::runtime_error("Scale-offset round trip failed at " + std::to_string(i));
+    // HDF5 adds the parameters of the type and fill value to the two given ones, 20 in total
+    auto filtersScaleOffset = file.openDataset("filterGroup/scaleOffset").getFilters();
+    if(filtersScaleOffset.size() != 1 or filtersScaleOffset[0].id != H5Z_FILTER_SCALEOFFSET or filtersScaleOffset[0].params.size() != 20 or
+       filtersScaleOffset[0].params[0] != H5Z_SO_FLOAT_DSCALE or filtersScaleOffset[0].params[1] != 3 or filtersScaleOffset[0].params[4] != sizeof(double))
+        throw std::runtime_error("Wrong scale-offset parameters on file");
+
+    // N-bit is lossless for native types
+    std::vector<int> vectorInt(1000);
+    std::iota(vectorInt.begin(), vectorInt.end(), 0);
+    file.writeDataset(vectorInt, "filterGroup/nbit", H5D_CHUNKED, std::nullopt, std::nullopt, std::vector<h5pp::Filter>{h5pp::filter::nbit()});
+    if(file.readDataset<std::vector<int>>("filterGroup/nbit") != vectorInt) throw std::runtime_error("N-bit round trip failed");
+
+    // Plugins are optional: they are used if available and skipped otherwise
+    for(auto &&filter : {h5pp::filter::zstd(), h5pp::filter::lz4(), h5pp::filter::blosc()}) {
+        bool available = h5pp::hdf5::checkIfFilterIsAvailable(filter.id);
+        std::cout << "Filter " << filter.name << " available: " << std::boolalpha << available << std::endl;
+        std::string dsetName = "filterGroup/" + filter.name;
+        file.writeDataset(vectorDouble, dsetName, H5D_CHUNKED, std::nullopt, std::nullopt, std::vector<h5pp::Filter>{filter});
+        if(hasFilter(file.openDataset(dsetName).getFilters(), filter.id) != available) throw std::runtime_error("Unexpected pipeline for plugin " + filter.name);
+        if(file.readDataset<std::vector<double>>(dsetName) != vectorDouble) throw std::runtime_error("Round trip failed for plugin " + filter.name);
+    }
+
+    // Mandatory filters that are not available should fail
+    try {
+        h5pp::Filter missing{31999, {}, H5Z_FLAG_MANDATORY, "missing"};
+        file.writeDataset(vectorDouble, "filterGroup/missing", H5D_CHUNKED, std::nullopt, std::nullopt, std::vector<h5pp::Filter>{missing});
+        throw std::logic_error("Using a missing mandatory filter should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+
+    // Default pipeline for all new datasets
+    file.setDefaultFilters({h5pp::filter::fletcher32()});
+    file.writeDataset(vectorDouble, "filterGroup/defaultPipeline", H5D_CHUNKED);
+    if(not hasFilter(file.openDataset("filterGroup/defaultPipeline").getFilters(), H5Z_FILTER_FLETCHER32)) throw std::runtime_error("Default filters were not applied");
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/hyperslab.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // A 1D dataset with values equal to their index
+    std::vector<double> vectorDouble(100);
+    std::iota(vectorDouble.begin(), vectorDouble.end(), 0.0);
+    file.writeDataset(vectorDouble, "hyperslabGroup/vectorDouble");
+
+    auto slice = file.readDataset<std::vector<double>>("hyperslabGroup/vectorDouble", {10}, {5});
+    if(slice != std::vector<double>{10, 11, 12, 13, 14}) throw std::runtime_error("Hyperslab read failed: wrong slice");
+    auto strided = file.readDataset<std::vector<double>>("hyperslabGroup/vectorDouble", {1}, {4}, std::vector<hsize_t>{10});
+    if(strided != std::vector<double>{1, 11, 21, 31}) throw std::runtime_error("Hyperslab read failed: wrong strided slice");
+
+    // Read into a preallocated raw buffer
+    double buffer[3];
+    file.readDataset(buffer, "hyperslabGroup/vectorDouble", {97}, {3});
+    if(buffer[0] != 97 or buffer[2] != 99) throw std::runtime_error("Hyperslab read failed: wrong values in raw buffer");
+
+    // Out of bounds selections should fail
+    try {
+        auto outOfBounds = file.readDataset<std::vector<double>>("hyperslabGroup/vectorDouble", {98}, {3});
+        throw std::logic_error("Reading out of bounds should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+
+    // Through a dataset handle
+    auto                dset = file.openDataset("hyperslabGroup/vectorDouble");
+    std::vector<double> sliceHandle;
+    dset.read(sliceHandle, {50}, {2});
+    if(sliceHandle != std::vector<double>{50, 51}) throw std::runtime_error("Hyperslab read through handle failed");
+
+    // Write tiles into an existing dataset
+    file.writeDataset(std::vector<double>(20, 0.0), "hyperslabGroup/vectorTiles");
+    file.writeDataset(std::vector<double>{1, 2, 3}, "hyperslabGroup/vectorTiles", {5});
+    file.writeDataset(std::vector<double>{7, 7}, "hyperslabGroup/vectorTiles", {10}, std::vector<hsize_t>{5});
+    auto vectorTiles = file.readDataset<std::vector<double>>("hyperslabGroup/vectorTiles");
+    for(size_t i = 0; i < vectorTiles.size(); i++) {
+        double expected = i >= 5 and i < 8 ? (double) i - 4 : (i == 10 or i == 15 ? 7.0 : 0.0);
+        if(vectorTiles[i] != expected) throw std::runtime_error("Hyperslab write failed: wrong value at " + std::to_string(i));
+    }
+    try {
+        file.writeDataset(std::vector<double>{1, 2, 3}, "hyperslabGroup/vectorTiles", {18});
+        throw std::logic_error("Writing out of bounds on a contiguous dataset should have failed");
+    } catch(std::runtime_error &ex) { std::cout << "\n THE ERROR IS PART OF THE TEST AND IS EXPECTED: " << ex.what() << std::endl; }
+
+    // Chunked datasets grow to fit the region
+    file.writeDataset(std::vector<double>(10, 0.0), "hyperslabGroup/vectorChunked", H5D_CHUNKED);
+    file.writeDataset(std::vector<double>{1, 2, 3}, "hyperslabGroup/vectorChunked", {20});
+    auto vectorChunked = file.readDataset<std::vector<double>>("hyperslabGroup/vectorChunked");
+    if(vectorChunked.size() != 23 or vectorChunked[20] != 1 or vectorChunked[22] != 3) throw std::runtime_error("Hyperslab write failed: chunked dataset did not grow");
+
+#ifdef H5PP_EIGEN3
+    // Column major matrices are transposed on write, so element (i,j) on file is matrix(i,j)
+    Eigen::MatrixXd matrixDouble = Eigen::MatrixXd::Random(10, 8);
+    file.writeDataset(matrixDouble, "hyperslabGroup/matrixDouble");
+    auto matrixSlice = file.readDataset<Eigen::MatrixXd>("hyperslabGroup/matrixDouble", {2, 3}, {4, 2});
+    if(matrixSlice != matrixDouble.block(2, 3, 4, 2)) throw std::runtime_error("Hyperslab read failed: wrong matrix slice");
+    auto matrixStrided = file.readDataset<Eigen::MatrixXd>("hyperslabGroup/matrixDouble", {0, 1}, {5, 4}, std::vector<hsize_t>{2, 2});
+    for(long i = 0; i < 5; i++)
+        for(long j = 0; j < 4; j++)
+            if(matrixStrided(i, j) != matrixDouble(2 * i, 1 + 2 * j)) throw std::runtime_error("Hyperslab read failed: wrong strided matrix slice");
+
+    // Read straight into blocks of existing matrices
+    Eigen::MatrixXd matrixColmajor = Eigen::MatrixXd::Zero(6, 6);
+    file.readDataset(matrixColmajor.block(1, 1, 3, 2), "hyperslabGroup/matrixDouble", {2, 3});
+    if(matrixColmajor.block(1, 1, 3, 2) != matrixDouble.block(2, 3, 3, 2)) throw std::runtime_error("Hyperslab read failed: wrong values in column-major block");
+    if(matrixColmajor(0, 0) != 0.0) throw std::runtime_error("Hyperslab read failed: values outside the block changed");
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> matrixRowmajor = Eigen::MatrixXd::Zero(6, 6);
+    file.readDataset(matrixRowmajor.block(2, 1, 4, 5), "hyperslabGroup/matrixDouble", {6, 0});
+    if(matrixRowmajor.block(2, 1, 4, 5) != matrixDouble.block(6, 0, 4, 5)) throw std::runtime_error("Hyperslab read failed: wrong values in row-major block");
+    if(matrixRowmajor(0, 0) != 0.0 or matrixRowmajor(2, 0) != 0.0) throw std::runtime_error("Hyperslab read failed: values outside the block changed");
+
+    // Write blocks of a domain-decomposed matrix, both with column and row-major storage
+    file.writeDataset(Eigen::MatrixXd::Zero(8, 8).eval(), "hyperslabGroup/matrixTiles");
+    Eigen::MatrixXd tileColmajor = Eigen::MatrixXd::Random(4, 3);
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> tileRowmajor = Eigen::MatrixXd::Random(2, 5);
+    file.writeDataset(tileColmajor, "hyperslabGroup/matrixTiles", {4, 5});
+    file.writeDataset(tileRowmajor, "hyperslabGroup/matrixTiles", {0, 1});
+    auto matrixTiles = file.readDataset<Eigen::MatrixXd>("hyperslabGroup/matrixTiles");
+    if(matrixTiles.block(4, 5, 4, 3) != tileColmajor) throw std::runtime_error("Hyperslab write failed: wrong column-major tile");
+    if(matrixTiles.block(0, 1, 2, 5) != tileRowmajor) throw std::runtime_error("Hyperslab write failed: wrong row-major tile");
+    if(matrixTiles(3, 3) != 0.0) throw std::runtime_error("Hyperslab write failed: values outside the tiles changed");
+
+    // A slice of a tensor
+    Eigen::Tensor<double, 3> tensorDouble(4, 5, 6);
+    tensorDouble.setRandom();
+    file.writeDataset(tensorDouble, "hyperslabGroup/tensorDouble");
+    auto tensorSlice = file.readDataset<Eigen::Tensor<double, 3>>("hyperslabGroup/tensorDouble", {1, 2, 3}, {2, 2, 2});
+    for(long i = 0; i < 2; i++)
+        for(long j = 0; j < 2; j++)
+            for(long k = 0; k < 2; k++)
+                if(tensorSlice(i, j, k) != tensorDouble(1 + i, 2 + j, 3 + k)) throw std::runtime_error("Hyperslab read failed: wrong tensor slice");
+#endif
+    return 0;
+}
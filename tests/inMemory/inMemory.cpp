@@ -0,0 +1,98 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    size_t logLevel = 0;
+
+    // Without a backing store nothing is written to disk
+    h5pp::fs::remove("output/inMemory.h5");
+    std::vector<double> vector(1000, 3.14);
+    std::vector<std::byte> image;
+    {
+        auto file = h5pp::File::inMemory("output/inMemory.h5", false, h5pp::CreateMode::TRUNCATE, logLevel);
+        if(not file.isInMemory()) throw std::runtime_error("File is not in memory");
+        if(not file.fileIsValid()) throw std::runtime_error("In-memory file is not valid");
+        file.writeDataset(vector, "group/vector");
+        file.writeDataset(42, "group/int");
+        file.writeAttribute("text", "attribute", "group/int");
+        file.close(); // Keeps the file, which only exists in memory
+        if(file.readDataset<std::vector<double>>("group/vector") != vector) throw std::runtime_error("Mismatch in in-memory vector");
+        if(file.readDataset<int>("group/int") != 42) throw std::runtime_error("Mismatch in in-memory int");
+
+        // Copies share the contents
+        h5pp::File copy = file;
+        copy.writeDataset(7, "fromCopy");
+        if(file.readDataset<int>("fromCopy") != 7) throw std::runtime_error("Copy of in-memory file does not share its contents");
+
+        image = file.toBuffer();
+        if(image.empty()) throw std::runtime_error("Empty file image");
+    }
+    if(h5pp::fs::exists("output/inMemory.h5")) throw std::runtime_error("In-memory file without backing store was written to disk");
+
+    // The image opens again, read-only and read-write
+    {
+        auto readOnly = h5pp::File::fromBuffer(image, h5pp::AccessMode::READONLY, logLevel);
+        if(readOnly.readDataset<std::vector<double>>("group/vector") != vector) throw std::runtime_error("Mismatch in read-only image");
+        if(readOnly.readAttribute<std::string>("attribute", "group/int") != "text") throw std::runtime_error("Mismatch in image attribute");
+        try {
+            readOnly.writeDataset(1, "forbidden");
+            throw std::logic_error("Wrote to read-only image");
+        } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+        if(readOnly.toBuffer().size() != image.size()) throw std::runtime_error("Image of read-only file changed size");
+
+        auto readWrite = h5pp::File::fromBuffer(image.data(), image.size(), h5pp::AccessMode::READWRITE, logLevel);
+        readWrite.writeDataset(std::vector<int>{1, 2, 3}, "added");
+        if(readOnly.linkExists("added")) throw std::runtime_error("Writes to one image reached another");
+        auto modified = h5pp::File::fromBuffer(readWrite.toBuffer(), h5pp::AccessMode::READONLY, logLevel);
+        if(modified.readDataset<std::vector<int>>("added") != std::vector<int>{1, 2, 3}) throw std::runtime_error("Mismatch in modified image");
+    }
+
+    // Images of files on disk open in memory too
+    {
+        h5pp::File disk("output/inMemoryDisk.h5", h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+        disk.writeDataset(vector, "vector");
+        auto memory = h5pp::File::fromBuffer(disk.toBuffer(), h5pp::AccessMode::READONLY, logLevel);
+        if(memory.readDataset<std::vector<double>>("vector") != vector) throw std::runtime_error("Mismatch in image of disk file");
+    }
+
+    // With a backing store the file is written to disk when destroyed
+    h5pp::fs::remove("output/inMemoryBacked.h5");
+    {
+        auto file = h5pp::File::inMemory("output/inMemoryBacked.h5", true, h5pp::CreateMode::TRUNCATE, logLevel);
+        file.writeDataset(vector, "vector");
+    }
+    {
+        h5pp::File disk("output/inMemoryBacked.h5", h5pp::AccessMode::READONLY, h5pp::CreateMode::OPEN, logLevel);
+        if(disk.readDataset<std::vector<double>>("vector") != vector) throw std::runtime_error("Mismatch in backing store");
+    }
+
+    // A backing store that exists is renamed by default, loaded with OPEN, and only overwritten with TRUNCATE
+    std::string renamedPath;
+    {
+        auto renamed = h5pp::File::inMemory("output/inMemoryBacked.h5", true, h5pp::CreateMode::RENAME, logLevel);
+        if(renamed.getFileName() == "inMemoryBacked.h5") throw std::runtime_error("Existing backing store was not renamed");
+        renamedPath = renamed.getFilePath();
+        renamed.writeDataset(1, "renamed");
+        auto opened = h5pp::File::inMemory("output/inMemoryBacked.h5", true, h5pp::CreateMode::OPEN, logLevel);
+        if(opened.readDataset<std::vector<double>>("vector") != vector) throw std::runtime_error("Backing store was not loaded");
+        opened.writeDataset(2, "opened");
+    }
+    if(h5pp::File(renamedPath, h5pp::AccessMode::READONLY, h5pp::CreateMode::OPEN, logLevel).readDataset<int>("renamed") != 1)
+        throw std::runtime_error("Mismatch in renamed backing store");
+    h5pp::fs::remove(renamedPath);
+    {
+        h5pp::File disk("output/inMemoryBacked.h5", h5pp::AccessMode::READONLY, h5pp::CreateMode::OPEN, logLevel);
+        if(disk.readDataset<std::vector<double>>("vector") != vector) throw std::runtime_error("Backing store was overwritten");
+        if(disk.readDataset<int>("opened") != 2) throw std::runtime_error("Changes to a loaded backing store were lost");
+    }
+    {
+        auto truncated = h5pp::File::inMemory("output/inMemoryBacked.h5", true, h5pp::CreateMode::TRUNCATE, logLevel);
+        if(truncated.linkExists("vector")) throw std::runtime_error("Backing store was not truncated");
+    }
+
+    try {
+        auto broken = h5pp::File::fromBuffer(vector.data(), vector.size() * sizeof(double), h5pp::AccessMode::READONLY, logLevel);
+        throw std::logic_error("Opened an invalid file image");
+    } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/ioStats.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Nothing is collected unless enabled
+    file.writeDataset(std::vector<double>(10, 1.0), "ioStatsGroup/before");
+    if(file.getCollectStats()) throw std::runtime_error("Statistics should be disabled by default");
+    try {
+        [[maybe_unused]] auto stats = file.getStats();
+        throw std::logic_error("Getting disabled statistics should have failed");
+    } catch(const std::runtime_error &err) { std::cout << "Caught expected error: " << err.what() << std::endl; }
+
+    file.setCollectStats();
+    std::vector<double> data(100, 2.0);
+    file.writeDataset(data, "ioStatsGroup/data");
+    file.writeDataset(data, "ioStatsGroup/data");
+    file.readDataset(data, "ioStatsGroup/data");
+    file.writeAttribute(1.0, "attr", "ioStatsGroup/data");
+    auto attr  = file.readAttribute<double>("attr", "ioStatsGroup/data");
+    auto stats = file.getStats();
+    std::cout << stats.toJson() << std::endl;
+    if(attr != 1.0) throw std::runtime_error("Failed to read attribute");
+    if(stats.fileOpens.count != 5) throw std::runtime_error("Expected 5 file opens, got " + std::to_string(stats.fileOpens.count));
+    if(stats.datasetCreates.count != 1) throw std::runtime_error("Expected 1 dataset create, got " + std::to_string(stats.datasetCreates.count));
+    if(stats.datasetWrites.count != 2 or stats.datasetWrites.bytes != 2 * data.size() * sizeof(double)) throw std::runtime_error("Wrong count of dataset writes");
+    if(stats.datasetReads.count != 1 or stats.datasetReads.bytes != data.size() * sizeof(double)) throw std::runtime_error("Wrong count of dataset reads");
+    if(stats.attributeWrites.count != 1 or stats.attributeReads.count != 1) throw std::runtime_error("Wrong count of attribute writes or reads");
+    if(stats.propertyScans.count != 5) throw std::runtime_error("Expected 5 property scans, got " + std::to_string(stats.propertyScans.count));
+    if(stats.datasetWrites.nanoseconds == 0 or stats.fileOpens.nanoseconds == 0) throw std::runtime_error("Nothing was timed");
+    if(stats.metadataCacheHitRate) throw std::runtime_error("The metadata cache is only known in keep-open mode");
+
+    // The file handle is reused in keep-open mode
+    file.resetStats();
+    file.setKeepFileOpen();
+    for(int i = 0; i < 10; i++) file.writeDataset(data, "ioStatsGroup/data");
+    stats = file.getStats();
+    if(stats.fileOpens.count != 1 or stats.datasetWrites.count != 10) throw std::runtime_error("Wrong counts in keep-open mode");
+    if(not stats.metadataCacheHitRate) throw std::runtime_error("Missing metadata cache hit rate in keep-open mode");
+    file.setKeepFileOpen(false);
+
+    // The bytes transferred are counted, not the bytes stored, which are fewer when compressed
+    if(h5pp::hdf5::checkIfCompressionIsAvailable()) {
+        file.writeDataset(std::vector<double>(10000, 0.0), "ioStatsGroup/compressed", H5D_CHUNKED, std::nullopt, 6);
+        file.resetStats();
+        auto compressed = file.readDataset<std::vector<double>>("ioStatsGroup/compressed");
+        if(file.getStats().datasetReads.bytes != compressed.size() * sizeof(double)) throw std::runtime_error("Wrong bytes of a compressed dataset read");
+    }
+
+#ifdef H5PP_EIGEN3
+    // Column-major objects are converted to the row-major layout on file
+    file.resetStats();
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(10, 5);
+    file.writeDataset(matrix, "ioStatsGroup/matrix");
+    file.readDataset(matrix, "ioStatsGroup/matrix");
+    stats = file.getStats();
+    if(stats.layoutConversions.count != 2) throw std::runtime_error("Expected 2 layout conversions, got " + std::to_string(stats.layoutConversions.count));
+#endif
+
+    // Another file does not count into the statistics of this one
+    {
+        h5pp::File other("output/ioStatsOther.h5", h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+        file.resetStats();
+        other.writeDataset(data, "data");
+        if(file.getStats().datasetWrites.count != 0) throw std::runtime_error("Writes to another file were counted");
+    }
+
+    file.setCollectStats(false);
+    if(file.getCollectStats()) throw std::runtime_error("Failed to disable statistics");
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+#include <set>
+
+int main() {
+    std::string outputFilename = "output/iterateDataset.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    std::vector<double> vector(10007);
+    for(size_t i = 0; i < vector.size(); i++) vector[i] = static_cast<double>(i) * 0.5;
+    file.writeDataset(vector, "vector", H5D_CHUNKED, std::vector<hsize_t>{512}, 3);
+
+    // Blocks of 1000 rows and a last block of 7, read on this thread or ahead into a ring of buffers
+    for(size_t readAhead : {0ul, 1ul, 3ul}) {
+        auto                     blocks = file.iterateDataset<std::vector<double>>("vector", 1000, readAhead);
+        std::vector<double>      joined;
+        size_t                   numBlocks = 0;
+        std::set<const double *> buffers;
+        for(auto &block : blocks) {
+            if(block.size() != std::min<size_t>(1000, vector.size() - blocks.getBlockOffset())) throw std::runtime_error("Wrong block size");
+            buffers.insert(block.data());
+            joined.insert(joined.end(), block.begin(), block.end());
+            numBlocks++;
+        }
+        if(numBlocks != 11 or blocks.getNumBlocks() != 11) throw std::runtime_error("Wrong number of blocks");
+        if(joined != vector) throw std::runtime_error("Mismatch in blocks of vector");
+        if(buffers.size() != readAhead + 1 or blocks.getReadAhead() != readAhead) throw std::runtime_error("Block buffers were not reused");
+        auto stats = blocks.getStats();
+        if(stats.reads.count != 11 or stats.reads.bytes != vector.size() * sizeof(double)) throw std::runtime_error("Wrong statistics of block reads");
+        if(readAhead == 0 and stats.stalls.count != 0) throw std::runtime_error("Stalled without read-ahead");
+        std::cout << "Read-ahead " << readAhead << ": read " << stats.reads.nanoseconds << " ns | stalled " << stats.stalls.count << " times, "
+                  << stats.stalls.nanoseconds << " ns" << std::endl;
+    }
+
+    // Blocks of a two-dimensional dataset hold whole rows, in row-major order
+    std::vector<int> table(1000 * 13);
+    for(size_t i = 0; i < table.size(); i++) table[i] = static_cast<int>(i);
+    file.writeDataset(table.data(), {1000, 13}, "table", H5D_CHUNKED);
+    std::vector<int> joined;
+    for(auto &block : file.iterateDataset<std::vector<int>>("table", 300, 2)) joined.insert(joined.end(), block.begin(), block.end());
+    if(joined != table) throw std::runtime_error("Mismatch in blocks of table");
+
+#ifdef H5PP_EIGEN3
+    // Column-major matrices are transposed block by block
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(250, 40);
+    file.writeDataset(matrix, "matrix");
+    Eigen::Index row = 0;
+    for(auto &block : file.iterateDataset<Eigen::MatrixXd>("matrix", 64, 2)) {
+        if(block != matrix.middleRows(row, block.rows())) throw std::runtime_error("Mismatch in blocks of matrix");
+        row += block.rows();
+    }
+    if(row != matrix.rows()) throw std::runtime_error("Wrong number of rows in blocks of matrix");
+#endif
+
+    // Leaving the loop early stops the blocks being read ahead
+    for(auto &block : file.iterateDataset<std::vector<double>>("vector", 100, 4)) {
+        if(block.front() != 0.0) throw std::runtime_error("Mismatch in first block");
+        break;
+    }
+
+    try {
+        auto blocks = file.iterateDataset<std::vector<double>>("vector", 0);
+        throw std::logic_error("Accepted blocks of zero rows");
+    } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+    try {
+        auto blocks = file.iterateDataset<std::vector<double>>("vector", 100);
+        for(auto &block : blocks) (void) block;
+        for(auto &block : blocks) (void) block;
+        throw std::logic_error("Iterated twice");
+    } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+    return 0;
+}
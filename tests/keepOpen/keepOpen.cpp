@@ -0,0 +1,37 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/keepOpen.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Keep a single file handle open while writing many small datasets
+    file.setKeepFileOpen();
+    if(not file.getKeepFileOpen()) throw std::runtime_error("Failed to enable keep-open mode");
+    for(int i = 0; i < 100; i++) file.writeDataset(i, "keepOpenGroup/int_" + std::to_string(i));
+    std::vector<double> vectorDouble(100, 3.14);
+    file.writeDataset(vectorDouble, "keepOpenGroup/vectorDouble");
+    file.flush();
+
+    // Read back using the same handle
+    for(int i = 0; i < 100; i++) {
+        auto value = file.readDataset<int>("keepOpenGroup/int_" + std::to_string(i));
+        if(value != i) throw std::runtime_error("Read wrong value: " + std::to_string(value) + " != " + std::to_string(i));
+    }
+    if(file.readDataset<std::vector<double>>("keepOpenGroup/vectorDouble") != vectorDouble) throw std::runtime_error("vectorDouble != vectorDoubleRead");
+
+    // Closing the handle should not prevent further use, the file is reopened on the next call
+    file.close();
+    file.writeDataset(vectorDouble, "keepOpenGroup/vectorDouble");
+
+    // Copies get their own handle
+    h5pp::File fileCopy(file);
+    if(not fileCopy.getKeepFileOpen()) throw std::runtime_error("Keep-open mode was not copied");
+    if(fileCopy.readDataset<std::vector<double>>("keepOpenGroup/vectorDouble") != vectorDouble) throw std::runtime_error("vectorDouble != vectorDoubleRead in copy");
+
+    // Back to opening and closing on every call
+    file.setKeepFileOpen(false);
+    if(file.readDataset<int>("keepOpenGroup/int_42") != 42) throw std::runtime_error("Failed to read after disabling keep-open mode");
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/linkCache.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // In keep-open mode, links that have been written or read are remembered
+    file.setKeepFileOpen();
+    for(int step = 0; step < 10; step++) {
+        std::string group = "run/step_" + std::to_string(step) + "/fields";
+        for(int i = 0; i < 10; i++) file.writeDataset(std::vector<double>(10, step + i), group + "/rho_" + std::to_string(i));
+        // Overwrite the same datasets, now with their paths known to exist
+        for(int i = 0; i < 10; i++) file.writeDataset(std::vector<double>(10, step * i), group + "/rho_" + std::to_string(i));
+    }
+    for(int step = 0; step < 10; step++) {
+        std::string group = "run/step_" + std::to_string(step) + "/fields";
+        for(int i = 0; i < 10; i++)
+            if(file.readDataset<std::vector<double>>(group + "/rho_" + std::to_string(i)) != std::vector<double>(10, step * i))
+                throw std::runtime_error("Read wrong values from " + group + "/rho_" + std::to_string(i));
+    }
+
+    // Prefixes of cached datasets are groups
+    if(not file.linkExists("run/step_3/fields")) throw std::runtime_error("Group run/step_3/fields should exist");
+    if(file.linkExists("run/step_3/fields/missing")) throw std::runtime_error("Link run/step_3/fields/missing should not exist");
+    file.createGroup("run/step_3");
+    file.createGroup("run/step_3/extra");
+    if(not file.linkExists("run/step_3/extra")) throw std::runtime_error("Group run/step_3/extra should exist");
+    file.writeDataset(1.0, "run/step_3/extra/value");
+    if(file.readDataset<double>("run/step_3/extra/value") != 1.0) throw std::runtime_error("Failed to read run/step_3/extra/value");
+
+    // Appending and hyperslab writes use the cache as well
+    file.appendToDataset(std::vector<double>(10, 6.0), "run/step_0/fields/series");
+    file.appendToDataset(std::vector<double>(5, 7.0), "run/step_0/fields/series");
+    file.writeDataset(std::vector<double>(2, 8.0), "run/step_0/fields/series", {0});
+    auto appended = file.readDataset<std::vector<double>>("run/step_0/fields/series");
+    if(appended.size() != 15 or appended[0] != 8.0 or appended[9] != 6.0 or appended[14] != 7.0) throw std::runtime_error("Append or hyperslab write through the cache failed");
+
+    // Closing forgets the cached links, but the file still works as before
+    file.close();
+    if(not file.linkExists("run/step_9/fields/rho_9")) throw std::runtime_error("Link run/step_9/fields/rho_9 should exist after close");
+    file.setKeepFileOpen(false);
+    if(file.readDataset<std::vector<double>>("run/step_9/fields/rho_9") != std::vector<double>(10, 81.0)) throw std::runtime_error("Failed to read after disabling keep-open mode");
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/mapDataset.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    std::vector<double> vector(100000);
+    for(size_t i = 0; i < vector.size(); i++) vector[i] = static_cast<double>(i) * 0.5;
+    file.writeDataset(vector, "contiguous", H5D_CONTIGUOUS);
+    file.writeDataset(vector, "chunked", H5D_CHUNKED, std::vector<hsize_t>{1000}, 3);
+    file.writeDataset(std::vector<float>(10, 1.0f), "float", H5D_CONTIGUOUS);
+
+    // Contiguous datasets are mapped without copying. The first one is aligned for any type
+    {
+        auto view = file.mapDataset<double>("contiguous");
+        if(not view.isMapped()) throw std::runtime_error("Contiguous dataset was not mapped");
+        if(view.size() != vector.size() or view.dims() != std::vector<hsize_t>{vector.size()}) throw std::runtime_error("Wrong size of mapped dataset");
+        if(not std::equal(view.begin(), view.end(), vector.begin())) throw std::runtime_error("Mismatch in mapped dataset");
+        auto moved = std::move(view);
+        if(moved[12345] != vector[12345]) throw std::runtime_error("Mismatch after moving mapped dataset");
+    }
+
+    // Chunked datasets are read instead
+    {
+        auto view = file.mapDataset<double>("chunked");
+        if(view.isMapped()) throw std::runtime_error("Chunked dataset was mapped");
+        if(not std::equal(view.begin(), view.end(), vector.begin(), vector.end())) throw std::runtime_error("Mismatch in read chunked dataset");
+        // Whether this one is mapped depends on the alignment of its offset in the file
+        auto floats = file.mapDataset<float>("float");
+        if(floats.size() != 10 or floats[9] != 1.0f) throw std::runtime_error("Mismatch in floats");
+    }
+
+    // Types that differ from the one on file are rejected, as by readDataset
+    try {
+        auto converted = file.mapDataset<double>("float");
+        throw std::logic_error("Mapped floats as doubles");
+    } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+
+    // Matrices are mapped in row-major order, as on file
+#ifdef H5PP_EIGEN3
+    Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> matrix(30, 40);
+    matrix.setRandom();
+    file.writeDataset(matrix, "matrix", H5D_CONTIGUOUS);
+    auto matrixView = file.mapDataset<int>("matrix");
+    Eigen::Map<const Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> map(matrixView.data(), matrixView.dims()[0], matrixView.dims()[1]);
+    if(map != matrix) throw std::runtime_error("Mismatch in mapped matrix");
+#endif
+
+    // Aligned allocations can always be mapped. In keep-open mode, recent writes are flushed before mapping
+    file.plists.file_access = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_alignment(file.plists.file_access, 1, 64);
+    file.setKeepFileOpen();
+    file.writeDataset(std::vector<int>(1000, 7), "keepOpen", H5D_CONTIGUOUS);
+    auto keepOpenView = file.mapDataset<int>("keepOpen");
+    if(not keepOpenView.isMapped() or keepOpenView[999] != 7) throw std::runtime_error("Mismatch in mapped dataset in keep-open mode");
+
+    // In-memory files have nothing to map
+    auto memory = h5pp::File::inMemory("mapDataset", false, h5pp::CreateMode::TRUNCATE, logLevel);
+    memory.writeDataset(vector, "contiguous", H5D_CONTIGUOUS);
+    auto memoryView = memory.mapDataset<double>("contiguous");
+    if(memoryView.isMapped() or memoryView[100] != vector[100]) throw std::runtime_error("Mismatch in dataset of in-memory file");
+
+    try {
+        auto missing = file.mapDataset<double>("missing");
+        throw std::logic_error("Mapped a missing dataset");
+    } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/parallelRead.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+    file.setReadThreads(4);
+    if(file.getReadThreads() != 4) throw std::runtime_error("Wrong number of read threads");
+
+    // Dimensions that are not multiples of the chunk dimensions give clipped chunks on the edges
+    std::vector<double> vector(100003);
+    for(size_t i = 0; i < vector.size(); i++) vector[i] = std::sin(static_cast<double>(i) * 1e-3);
+    file.writeDataset(vector, "deflate", H5D_CHUNKED, std::vector<hsize_t>{1000}, 6);
+    file.writeDataset(vector, "shuffle", H5D_CHUNKED, std::vector<hsize_t>{1000}, std::nullopt, std::vector<h5pp::Filter>{h5pp::filter::shuffle(), h5pp::filter::deflate(3)});
+    file.writeDataset(vector, "uncompressed", H5D_CHUNKED, std::vector<hsize_t>{1000});
+    file.writeDataset(vector, "fletcher32", H5D_CHUNKED, std::vector<hsize_t>{1000}, std::nullopt, std::vector<h5pp::Filter>{h5pp::filter::deflate(3), h5pp::filter::fletcher32()});
+    for(const auto &name : {"deflate", "shuffle", "uncompressed", "fletcher32"}) {
+        auto read = file.readDataset<std::vector<double>>(name);
+        if(read != vector) throw std::runtime_error("Mismatch in parallel read of dataset: " + std::string(name));
+    }
+
+#if H5_VERSION_GE(1, 10, 3)
+    // Chunks may skip filters, e.g. when they didn't compress, which the filter mask of each chunk tells
+    file.writeDataset(vector, "masked", H5D_CHUNKED, std::vector<hsize_t>{1000}, 6);
+    {
+        h5pp::hid::h5f      handle = file.openFileHandle();
+        h5pp::hid::h5d      dset   = H5Dopen(handle, "masked", H5P_DEFAULT);
+        std::vector<double> twos(1000, 2.0);
+        hsize_t             offset[1] = {1000};
+        H5Dwrite_chunk(dset, H5P_DEFAULT, 1u, offset, twos.size() * sizeof(double), twos.data());
+    }
+    auto masked = file.readDataset<std::vector<double>>("masked");
+    if(masked[999] != vector[999] or masked[1000] != 2.0 or masked[1999] != 2.0 or masked[2000] != vector[2000])
+        throw std::runtime_error("Mismatch in parallel read of chunk without filters");
+#endif
+
+#ifdef H5PP_EIGEN3
+    // Several dimensions, and a column-major container that is transposed after reading
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(301, 203);
+    file.writeDataset(matrix, "matrix", H5D_CHUNKED, std::vector<hsize_t>{64, 50}, 4);
+    if(file.readDataset<Eigen::MatrixXd>("matrix") != matrix) throw std::runtime_error("Mismatch in parallel read of matrix");
+    Eigen::Tensor<float, 3> tensor(17, 30, 45);
+    tensor.setRandom();
+    file.writeDataset(tensor, "tensor", H5D_CHUNKED, std::vector<hsize_t>{5, 8, 16}, 2);
+    auto                   readTensor   = file.readDataset<Eigen::Tensor<float, 3>>("tensor");
+    Eigen::Tensor<bool, 0> tensorsEqual = (readTensor == tensor).all();
+    if(not tensorsEqual()) throw std::runtime_error("Mismatch in parallel read of tensor");
+#endif
+
+    // Unallocated chunks hold the fill value, and hyperslabs select part of the dataset: both are left to HDF5
+    {
+        h5pp::hid::h5f      handle  = file.openFileHandle();
+        hsize_t             dims[1] = {10000}, chunk[1] = {1000}, start[1] = {0}, count[1] = {3000};
+        h5pp::hid::h5s      space   = H5Screate_simple(1, dims, nullptr);
+        h5pp::hid::h5s      memory  = H5Screate_simple(1, count, nullptr);
+        h5pp::hid::h5p      create  = H5Pcreate(H5P_DATASET_CREATE);
+        std::vector<double> ones(3000, 1.0);
+        H5Pset_chunk(create, 1, chunk);
+        H5Pset_deflate(create, 3);
+        h5pp::hid::h5d dset = H5Dcreate(handle, "sparse", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, create, H5P_DEFAULT);
+        H5Sselect_hyperslab(space, H5S_SELECT_SET, start, nullptr, count, nullptr);
+        H5Dwrite(dset, H5T_NATIVE_DOUBLE, memory, space, H5P_DEFAULT, ones.data());
+    }
+    auto sparse = file.readDataset<std::vector<double>>("sparse");
+    if(sparse.size() != 10000 or sparse[2999] != 1.0 or sparse[3000] != 0.0) throw std::runtime_error("Mismatch in dataset with unallocated chunks");
+    auto slab   = file.readDataset<std::vector<double>>("deflate", {500}, {2000});
+    if(not std::equal(slab.begin(), slab.end(), vector.begin() + 500)) throw std::runtime_error("Mismatch in hyperslab of deflated dataset");
+
+    // The same results on one thread
+    file.setReadThreads(1);
+    if(file.readDataset<std::vector<double>>("shuffle") != vector) throw std::runtime_error("Mismatch in serial read");
+    try {
+        file.setReadThreads(0);
+        throw std::logic_error("Accepted zero read threads");
+    } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+    return 0;
+}
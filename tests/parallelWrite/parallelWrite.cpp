@@ -0,0 +1,76 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/parallelWrite.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+    file.setWriteThreads(4);
+    if(file.getWriteThreads() != 4) throw std::runtime_error("Wrong number of write threads");
+
+    // Dimensions that are not multiples of the chunk dimensions give clipped chunks on the edges. Reads are left to HDF5
+    std::vector<double> vector(100003);
+    for(size_t i = 0; i < vector.size(); i++) vector[i] = std::sin(static_cast<double>(i) * 1e-3);
+    file.writeDataset(vector, "deflate", H5D_CHUNKED, std::vector<hsize_t>{1000}, 6);
+    file.writeDataset(vector, "shuffle", H5D_CHUNKED, std::vector<hsize_t>{1000}, std::nullopt, std::vector<h5pp::Filter>{h5pp::filter::shuffle(), h5pp::filter::deflate(3)});
+    file.writeDataset(vector, "uncompressed", H5D_CHUNKED, std::vector<hsize_t>{1000});
+    file.writeDataset(vector, "fletcher32", H5D_CHUNKED, std::vector<hsize_t>{1000}, std::nullopt, std::vector<h5pp::Filter>{h5pp::filter::deflate(3), h5pp::filter::fletcher32()});
+    for(const auto &name : {"deflate", "shuffle", "uncompressed", "fletcher32"}) {
+        auto read = file.readDataset<std::vector<double>>(name);
+        if(read != vector) throw std::runtime_error("Mismatch in parallel write of dataset: " + std::string(name));
+    }
+    {
+        // The chunks are stored compressed
+        h5pp::hid::h5f handle = file.openFileHandle();
+        h5pp::hid::h5d dset   = H5Dopen(handle, "shuffle", H5P_DEFAULT);
+        if(H5Dget_storage_size(dset) >= vector.size() * sizeof(double)) throw std::runtime_error("Parallel write did not compress");
+    }
+
+    // Overwriting a whole dataset, and a hyperslab of it, which is left to HDF5
+    for(auto &v : vector) v *= 2;
+    file.writeDataset(vector, "deflate");
+    if(file.readDataset<std::vector<double>>("deflate") != vector) throw std::runtime_error("Mismatch in parallel overwrite");
+    std::vector<double> ones(2000, 1.0);
+    file.writeDataset(ones, "deflate", std::vector<hsize_t>{500});
+    auto slab = file.readDataset<std::vector<double>>("deflate");
+    if(slab[499] != vector[499] or slab[500] != 1.0 or slab[2499] != 1.0 or slab[2500] != vector[2500]) throw std::runtime_error("Mismatch in hyperslab write");
+
+#ifdef H5PP_EIGEN3
+    // Several dimensions, and a column-major container that is transposed before writing
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(301, 203);
+    file.writeDataset(matrix, "matrix", H5D_CHUNKED, std::vector<hsize_t>{64, 50}, 4);
+    if(file.readDataset<Eigen::MatrixXd>("matrix") != matrix) throw std::runtime_error("Mismatch in parallel write of matrix");
+    Eigen::Tensor<float, 3> tensor(17, 30, 45);
+    tensor.setRandom();
+    file.writeDataset(tensor, "tensor", H5D_CHUNKED, std::vector<hsize_t>{5, 8, 16}, 2);
+    auto                   readTensor   = file.readDataset<Eigen::Tensor<float, 3>>("tensor");
+    Eigen::Tensor<bool, 0> tensorsEqual = (readTensor == tensor).all();
+    if(not tensorsEqual()) throw std::runtime_error("Mismatch in parallel write of tensor");
+#endif
+
+    // A user-defined fill value pads the chunks on the edges, which is left to HDF5
+    {
+        h5pp::hid::h5f handle  = file.openFileHandle();
+        hsize_t        dims[1] = {2500}, chunk[1] = {1000};
+        double         fill    = -1.0;
+        h5pp::hid::h5s space   = H5Screate_simple(1, dims, nullptr);
+        h5pp::hid::h5p create  = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(create, 1, chunk);
+        H5Pset_deflate(create, 3);
+        H5Pset_fill_value(create, H5T_NATIVE_DOUBLE, &fill);
+        h5pp::hid::h5d dset = H5Dcreate(handle, "filled", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, create, H5P_DEFAULT);
+    }
+    std::vector<double> twos(2500, 2.0);
+    file.writeDataset(twos, "filled");
+    if(file.readDataset<std::vector<double>>("filled") != twos) throw std::runtime_error("Mismatch in dataset with fill value");
+
+    // The same results on one thread
+    file.setWriteThreads(1);
+    file.writeDataset(vector, "serial", H5D_CHUNKED, std::vector<hsize_t>{1000}, std::nullopt, std::vector<h5pp::Filter>{h5pp::filter::shuffle(), h5pp::filter::deflate(3)});
+    if(file.readDataset<std::vector<double>>("serial") != vector) throw std::runtime_error("Mismatch in serial write");
+    try {
+        file.setWriteThreads(0);
+        throw std::logic_error("Accepted zero write threads");
+    } catch(const std::runtime_error &ex) { std::cout << "Caught expected error: " << ex.what() << std::endl; }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+#include <thread>
+
+constexpr int numThreads = 8;
+constexpr int numDsets   = 25;
+
+template<typename Func>
+void runThreads(Func &&func) {
+    std::vector<std::thread>        threads;
+    std::vector<std::exception_ptr> errors(numThreads);
+    for(int t = 0; t < numThreads; t++)
+        threads.emplace_back([&func, &errors, t]() {
+            try {
+                func(t);
+            } catch(...) { errors[static_cast<size_t>(t)] = std::current_exception(); }
+        });
+    for(auto &thread : threads) thread.join();
+    for(auto &error : errors)
+        if(error) std::rethrow_exception(error);
+}
+
+std::vector<double> makeData(int thread, int dset) { return std::vector<double>(100, 1000.0 * thread + dset); }
+
+// A filter that changes nothing, and records the level of the global logger while HDF5 runs it during a call
+constexpr H5Z_filter_t loggerProbeId   = 256; // In the range reserved for testing
+spdlog::level::level_enum levelDuringCall = spdlog::level::off;
+size_t loggerProbe(unsigned int, size_t, const unsigned int[], size_t nbytes, size_t *, void **) {
+    levelDuringCall = h5pp::logger::log->level();
+    return nbytes;
+}
+const H5Z_class2_t loggerProbeClass = {H5Z_CLASS_T_VERS, loggerProbeId, 1, 1, "loggerProbe", nullptr, nullptr, loggerProbe};
+
+int main() {
+    size_t logLevel = 0;
+
+    // Each thread with its own file
+    runThreads([logLevel](int t) {
+        h5pp::File file("output/threadSafety_" + std::to_string(t) + ".h5", h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+        for(int d = 0; d < numDsets; d++) {
+            file.writeDataset(makeData(t, d), "dsets/dset_" + std::to_string(d));
+            file.writeAttribute(d, "index", "dsets/dset_" + std::to_string(d));
+        }
+        for(int d = 0; d < numDsets; d++) {
+            if(file.readDataset<std::vector<double>>("dsets/dset_" + std::to_string(d)) != makeData(t, d)) throw std::runtime_error("Mismatch in own file");
+            if(file.readAttribute<int>("index", "dsets/dset_" + std::to_string(d)) != d) throw std::runtime_error("Mismatch in attribute");
+        }
+    });
+
+    // All threads sharing one file, with and without keeping it open
+    for(bool keepOpen : {false, true}) {
+        h5pp::File file("output/threadSafety.h5", h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+        file.setKeepFileOpen(keepOpen);
+        runThreads([&file](int t) {
+            std::string group = "thread_" + std::to_string(t);
+            for(int d = 0; d < numDsets; d++) {
+                file.writeDataset(makeData(t, d), group + "/dset_" + std::to_string(d));
+                if(not file.linkExists(group + "/dset_" + std::to_string(d))) throw std::runtime_error("Missing link in shared file");
+            }
+            for(int d = 0; d < numDsets; d++)
+                if(file.readDataset<std::vector<double>>(group + "/dset_" + std::to_string(d)) != makeData(t, d)) throw std::runtime_error("Mismatch in shared file");
+
+            // Copies of a file, made while other threads log
+            h5pp::File copy = file;
+            if(copy.readDataset<std::vector<double>>(group + "/dset_0") != makeData(t, 0)) throw std::runtime_error("Mismatch in copied file");
+
+            // Dataset handles and appends
+            auto dset = file.openDataset(group + "/dset_0");
+            for(int d = 0; d < numDsets; d++) dset.write(makeData(t, d));
+            if(dset.read<std::vector<double>>() != makeData(t, numDsets - 1)) throw std::runtime_error("Mismatch in dataset handle");
+            for(int d = 0; d < numDsets; d++) file.appendToDataset(makeData(t, d), group + "/series");
+            if(file.getDatasetDimensions(group + "/series") != std::vector<hsize_t>{numDsets * 100}) throw std::runtime_error("Wrong number of appended rows");
+
+            // Asynchronous writes, queued from all threads at once
+            std::vector<std::future<void>> futures;
+            for(int d = 0; d < numDsets; d++) futures.push_back(file.writeDatasetAsync(makeData(t, d), group + "/async_" + std::to_string(d)));
+            for(auto &future : futures) future.get();
+        });
+        for(int t = 0; t < numThreads; t++)
+            if(file.getContentsOfGroup("thread_" + std::to_string(t)).size() != 2 * numDsets + 1) throw std::runtime_error("Wrong number of datasets");
+    }
+    {
+        // Each file logs at its own level during its calls, seen from a filter that HDF5 runs while writing
+        H5Zregister(&loggerProbeClass);
+        std::vector<h5pp::Filter> probe   = {h5pp::Filter{loggerProbeId, {}, H5Z_FLAG_MANDATORY, "loggerProbe"}};
+        auto                      global  = h5pp::logger::log;
+        h5pp::File                verbose("output/threadSafetyVerbose.h5", h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, 0);
+        h5pp::File                quiet("output/threadSafetyQuiet.h5", h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, 5);
+        quiet.setLogLevel(4);
+        verbose.writeDataset(makeData(0, 0), "value", H5D_CHUNKED, std::nullopt, std::nullopt, probe);
+        if(levelDuringCall != spdlog::level::trace) throw std::runtime_error("A call on a file did not log to its own logger");
+        quiet.writeDataset(makeData(0, 0), "value", H5D_CHUNKED, std::nullopt, std::nullopt, probe);
+        if(levelDuringCall != spdlog::level::err) throw std::runtime_error("A call on a file did not log to its own logger");
+        if(h5pp::logger::log != global) throw std::runtime_error("The global logger was not restored after a call");
+    }
+    if(h5pp::counter::ActiveFileCounter::getCount() != 0) throw std::runtime_error("Files were not closed: " + h5pp::counter::ActiveFileCounter::OpenFileNames());
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+struct Field2 {
+    double x, y;
+};
+struct Field3 {
+    double x, y, z;
+};
+
+int main() {
+    std::string outputFilename = "output/typeCheck.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Repeated overwrites of a compound dataset with the same C++ type compare the types only once
+    h5pp::hdf5::typeMatchCache.clear();
+    std::vector<Field2> fields(10, {1.0, 2.0});
+    for(size_t i = 0; i < 5; i++) {
+        fields[0].x = static_cast<double>(i);
+        file.writeDataset(fields, "typeCheckGroup/fields");
+        file.writeAttribute(fields, "fields", "typeCheckGroup/fields");
+    }
+    if(h5pp::hdf5::typeMatchCache.size() != 1) throw std::runtime_error("Expected one cached type comparison, got " + std::to_string(h5pp::hdf5::typeMatchCache.size()));
+    if(file.readDataset<std::vector<Field2>>("typeCheckGroup/fields")[0].x != 4.0) throw std::runtime_error("Failed to overwrite compound dataset");
+
+    // A compound type with a different layout does not match
+    try {
+        file.writeDataset(std::vector<Field3>(10, {1.0, 2.0, 3.0}), "typeCheckGroup/fields");
+        throw std::logic_error("Writing a mismatching compound type should have failed");
+    } catch(const std::runtime_error &err) { std::cout << "Caught expected error: " << err.what() << std::endl; }
+    if(h5pp::hdf5::typeMatchCache.size() != 2) throw std::runtime_error("Expected two cached type comparisons");
+    try {
+        file.writeDataset(std::vector<Field3>(10, {1.0, 2.0, 3.0}), "typeCheckGroup/fields");
+        throw std::logic_error("Writing a mismatching compound type should have failed");
+    } catch(const std::runtime_error &err) { std::cout << "Caught expected error: " << err.what() << std::endl; }
+
+    // Native types are still checked
+    file.writeDataset(std::vector<double>(10, 1.0), "typeCheckGroup/doubles");
+    try {
+        file.writeDataset(std::vector<int>(10, 2), "typeCheckGroup/doubles");
+        throw std::logic_error("Writing a mismatching native type should have failed");
+    } catch(const std::runtime_error &err) { std::cout << "Caught expected error: " << err.what() << std::endl; }
+
+    // In trusted mode the types are not compared
+    h5pp::hdf5::typeMatchCache.clear();
+    file.setTrustedWrites();
+    file.writeDataset(std::vector<double>(10, 2.0), "typeCheckGroup/doubles");
+    if(file.readDataset<std::vector<double>>("typeCheckGroup/doubles")[9] != 2.0) throw std::runtime_error("Failed to write in trusted mode");
+    file.writeDataset(fields, "typeCheckGroup/fields");
+    file.writeAttribute(fields, "fields", "typeCheckGroup/fields");
+    if(not h5pp::hdf5::typeMatchCache.empty()) throw std::runtime_error("Types were compared in trusted mode");
+    file.setTrustedWrites(false);
+    if(file.getTrustedWrites()) throw std::runtime_error("Failed to leave trusted mode");
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+struct Field2 {
+    double x, y;
+};
+
+int main() {
+    std::string outputFilename = "output/typeRegistry.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+
+    // Types are created once and shared, so repeated lookups give the same identifier
+    auto typeDouble = h5pp::utils::getH5Type<double>();
+    if(h5pp::utils::getH5Type<std::vector<double>>().value() != typeDouble.value()) throw std::runtime_error("The type of double was not shared");
+    auto typeComplex = h5pp::utils::getH5Type<std::complex<double>>();
+    if(h5pp::utils::getH5Type<std::complex<double>>().value() != typeComplex.value()) throw std::runtime_error("The type of std::complex<double> was not shared");
+    if(H5Tget_class(typeComplex) != H5T_COMPOUND or H5Tget_nmembers(typeComplex) != 2) throw std::runtime_error("Wrong compound type for std::complex<double>");
+
+    // Text types are resized per call, so each call gets its own copy
+    if(h5pp::utils::getH5Type<std::string>().value() == h5pp::utils::getH5Type<std::string>().value()) throw std::runtime_error("Text types should not be shared");
+
+    // Different structs with the same layout share a type
+    std::vector<Field2> fields(10, {1.0, 2.0});
+    file.writeDataset(fields, "typeRegistryGroup/fields");
+    auto fieldsRead = file.readDataset<std::vector<Field2>>("typeRegistryGroup/fields");
+    if(fieldsRead.size() != 10 or fieldsRead[9].x != 1.0 or fieldsRead[9].y != 2.0) throw std::runtime_error("Failed to read Scalar2 type");
+
+    // Writing strings of different lengths must not affect each other
+    file.writeDataset(std::string("short"), "typeRegistryGroup/short");
+    file.writeDataset(std::string("a much longer string"), "typeRegistryGroup/long");
+    if(file.readDataset<std::string>("typeRegistryGroup/short") != "short") throw std::runtime_error("Failed to read short string");
+    if(file.readDataset<std::string>("typeRegistryGroup/long") != "a much longer string") throw std::runtime_error("Failed to read long string");
+
+    // Closing the registry does not invalidate types held elsewhere, and new types are created on the next lookup
+    h5pp::type::registry::closeTypes();
+    if(H5Iis_valid(typeDouble) <= 0) throw std::runtime_error("Held type was closed by the registry");
+    file.writeDataset(std::vector<std::complex<double>>(5, {1.0, 2.0}), "typeRegistryGroup/complex");
+    if(file.readDataset<std::vector<std::complex<double>>>("typeRegistryGroup/complex")[4] != std::complex<double>(1.0, 2.0)) throw std::runtime_error("Failed to read complex after closing types");
+    return 0;
+}
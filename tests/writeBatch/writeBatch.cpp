@@ -0,0 +1,69 @@
+#include <h5pp/h5pp.h>
+#include <iostream>
+
+int main() {
+    std::string outputFilename = "output/writeBatch.h5";
+    size_t      logLevel       = 0;
+    h5pp::File  file(outputFilename, h5pp::AccessMode::READWRITE, h5pp::CreateMode::TRUNCATE, logLevel);
+    file.setCollectStats();
+
+    // Heterogeneous items, across several groups. The data is copied, so it may change before the commit
+    auto                batch = file.beginBatch();
+    std::vector<double> vector(10, 1.0);
+    for(int i = 0; i < 100; i++) {
+        std::string group = "checkpoint/group_" + std::to_string(i % 10);
+        batch.writeDataset(i, group + "/int_" + std::to_string(i));
+        batch.writeDataset(vector, group + "/vector_" + std::to_string(i));
+        vector[0] += 1.0;
+    }
+    batch.writeDataset("some text", "checkpoint/text");
+    batch.writeDataset(std::string("more text"), "checkpoint/string");
+    batch.writeAttribute(42, "answer", "checkpoint/text");
+    if(batch.size() != 203) throw std::runtime_error("Wrong number of items in batch");
+
+    auto errors = batch.commit();
+    auto stats  = file.getStats();
+    for(const auto &error : errors) std::cout << "Unexpected error in item " << error.index << ": " << error.message << std::endl;
+    if(not errors.empty()) throw std::runtime_error("Batch failed");
+    if(not batch.empty()) throw std::runtime_error("Batch was not emptied by commit");
+    if(stats.fileOpens.count != 1) throw std::runtime_error("Expected the file to be opened once, got " + std::to_string(stats.fileOpens.count));
+    if(stats.datasetCreates.count != 202) throw std::runtime_error("Expected 202 datasets, got " + std::to_string(stats.datasetCreates.count));
+
+    for(int i = 0; i < 100; i++) {
+        std::string group = "checkpoint/group_" + std::to_string(i % 10);
+        if(file.readDataset<int>(group + "/int_" + std::to_string(i)) != i) throw std::runtime_error("Mismatch in batched int");
+        auto readVector = file.readDataset<std::vector<double>>(group + "/vector_" + std::to_string(i));
+        if(readVector.size() != 10 or readVector[0] != 1.0 + i) throw std::runtime_error("Mismatch in batched vector");
+    }
+    if(file.readDataset<std::string>("checkpoint/text") != "some text") throw std::runtime_error("Mismatch in batched text");
+    if(file.readDataset<std::string>("checkpoint/string") != "more text") throw std::runtime_error("Mismatch in batched string");
+    if(file.readAttribute<int>("answer", "checkpoint/text") != 42) throw std::runtime_error("Mismatch in batched attribute");
+
+    // Errors are reported per item, and the other items are still written
+    batch.writeDataset(7, "checkpoint/group_0/int_0");                                    // Overwrite
+    batch.writeDataset(std::vector<double>(3, 1.0), "checkpoint/group_0/int_0");           // Wrong rank
+    batch.writeAttribute(1.0, "attr", "checkpoint/missing");                                // No such link
+    batch.writeDataset(std::vector<int>{1, 2, 3}, "checkpoint/group_0/int_0/not_a_group"); // Parent is a dataset
+    batch.writeDataset(8, "checkpoint/new");
+    errors = batch.commit();
+    for(const auto &error : errors) std::cout << "Caught expected error in item " << error.index << ": " << error.message << std::endl;
+    if(errors.size() != 3 or errors[0].index != 1 or errors[1].index != 2 or errors[2].index != 3) throw std::runtime_error("Wrong errors reported");
+    if(errors[1].linkName != "checkpoint/missing" or errors[1].attrName != "attr") throw std::runtime_error("Wrong names in error");
+    if(file.readDataset<int>("checkpoint/group_0/int_0") != 7) throw std::runtime_error("Overwrite in batch failed");
+    if(file.readDataset<int>("checkpoint/new") != 8) throw std::runtime_error("Item after errors was not written");
+
+    // Keep-open mode shares the link cache with the batch
+    file.setKeepFileOpen();
+    for(int i = 0; i < 10; i++) batch.writeDataset(i, "keepOpen/int_" + std::to_string(i));
+    if(not batch.commit().empty()) throw std::runtime_error("Batch failed in keep-open mode");
+    if(file.readDataset<int>("keepOpen/int_9") != 9) throw std::runtime_error("Mismatch in keep-open batch");
+
+    h5pp::File readOnly(outputFilename, h5pp::AccessMode::READONLY, h5pp::CreateMode::OPEN, logLevel);
+    auto       readOnlyBatch = readOnly.beginBatch();
+    readOnlyBatch.writeDataset(1, "readOnly");
+    try {
+        [[maybe_unused]] auto unused = readOnlyBatch.commit();
+        throw std::logic_error("Committing to a read-only file should have failed");
+    } catch(const std::runtime_error &err) { std::cout << "Caught expected error: " << err.what() << std::endl; }
+    return 0;
+}